@@ -0,0 +1,334 @@
+// ---------------------------
+// projects/life/BenchLife.c++
+// ---------------------------
+
+// --------
+// includes
+// --------
+
+#include <atomic>    // atomic
+#include <cstdlib>   // malloc, free
+#include <iostream>  // ostream, streambuf
+#include <new>       // bad_alloc
+#include <sstream>   // istringstream
+#include <string>    // string
+
+#include "benchmark/benchmark.h"
+
+#include "BitLife.h"
+#include "FredkinLife.h"
+#include "HashLife.h"
+#include "Life.h"
+#include "LutLife.h"
+#include "StreamLife.h"
+#include "TiledLife.h"
+
+// -----------
+// allocations
+// -----------
+
+namespace {
+
+std::atomic<long long> allocations(0);	// every operator new since the program started
+
+}
+
+// kept out of line, so the compiler does not pair the calls to new with free
+__attribute__((noinline))
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline))
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline))
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline))
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline))
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// -------
+// helpers
+// -------
+
+/**
+ * a board in the format Life reads, the same one for the same arguments
+ * @param h the height of the board
+ * @param w the width of the board
+ * @param percent the chance out of 100 of a cell being glyphs[0], otherwise glyphs[1]
+ * @param glyphs the live and dead symbols
+ */
+std::string make_board(int h, int w, int percent, const char* glyphs) {
+    std::string board;
+    board.reserve((h + 1) * (w + 1));
+    unsigned seed = 12345;
+    for (int x = 0; x < h; x++) {
+        for (int y = 0; y < w; y++) {
+            seed = seed * 1103515245 + 12345;
+            board += ((seed >> 16) % 100 < (unsigned) percent) ? glyphs[0] : glyphs[1];
+        }
+        board += '\n';
+    }
+    return board + '\n';
+}
+
+template <class T>
+const char* glyphs();
+
+template <>
+const char* glyphs<ConwayCell>() { return "*."; }
+
+template <>
+const char* glyphs<FredkinCell>() { return "0-"; }
+
+template <>
+const char* glyphs<Cell>() { return "*-"; }
+
+/**
+ * a streambuf that drops everything, so print is measured without the cost of a file or a string
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+/**
+ * report cells per second and allocations per iteration
+ */
+void report(benchmark::State& state, long long cells, long long allocated) {
+    state.counters["cells/s"] = benchmark::Counter(cells * state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["allocs"] = benchmark::Counter(allocated, benchmark::Counter::kAvgIterations);
+}
+
+// ---------
+// Life<T>
+// ---------
+
+template <class T>
+void BM_construct(benchmark::State& state) {
+    const int n = state.range(0);
+    const std::string board = make_board(n, n, state.range(1), glyphs<T>());
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        std::istringstream in(board);
+        Life<T> l(in, n, n);
+        benchmark::DoNotOptimize(l.at(0, 0));
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+template <class T>
+void BM_evolve_all(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), glyphs<T>()));
+    Life<T> l(in, n, n);
+    l.evolve_all();
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        l.evolve_all();
+        benchmark::ClobberMemory();
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+template <class T>
+void BM_print(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), glyphs<T>()));
+    Life<T> l(in, n, n);
+    NullBuffer buffer;
+    std::ostream out(&buffer);
+
+    const long long before = allocations;
+    for (auto _ : state)
+        l.print(out);
+    report(state, (long long) n * n, allocations - before);
+}
+
+template <class T>
+void BM_iterate(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), glyphs<T>()));
+    const Life<T> l(in, n, n);
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        int live = 0;
+        for (typename Life<T>::template const_iterator<T> b = l.begin(); b != l.end(); ++b)
+            live += (*b).is_alive();
+        benchmark::DoNotOptimize(live);
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+template <class T>
+void BM_rows(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), glyphs<T>()));
+    const Life<T> l(in, n, n);
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        int live = 0;
+        for (int x = 0; x < n; x++)
+            for (const T& c : l.row(x))
+                live += c.is_alive();
+        benchmark::DoNotOptimize(live);
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+// -------
+// engines
+// -------
+
+void BM_bitlife_evolve_all(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), "*."));
+    BitLife l(in, n, n);
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        l.evolve_all();
+        benchmark::ClobberMemory();
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+void BM_fredkinlife_evolve_all(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), "0-"));
+    FredkinLife l(in, n, n);
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        l.evolve_all();
+        benchmark::ClobberMemory();
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+void BM_lutlife_evolve_all(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), "*."));
+    LutLife<> l(in, n, n);
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        l.evolve_all();
+        benchmark::ClobberMemory();
+    }
+    report(state, (long long) n * n, allocations - before);
+}
+
+void BM_streamlife_run(benchmark::State& state) {
+    const int n = state.range(0);
+    const std::string board = make_board(n, n, state.range(1), "*.");
+
+    const long long before = allocations;
+    for (auto _ : state) {
+        std::istringstream in(board);
+        std::ostringstream out;
+        StreamLife<ConwayCell> s(n, n, 4);
+        s.run(in, out);
+        benchmark::DoNotOptimize(s.population());
+    }
+    report(state, 4LL * n * n, allocations - before);
+}
+
+void BM_tiledlife_evolve(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), "*."));
+    TiledLife<ConwayCell> l(in, n, n);
+
+    // 4 generations per iteration, one halo exchange
+    const long long before = allocations;
+    for (auto _ : state) {
+        l.evolve(4);
+        benchmark::ClobberMemory();
+    }
+    report(state, 4LL * n * n, allocations - before);
+}
+
+void BM_hashlife_evolve_all(benchmark::State& state) {
+    const int n = state.range(0);
+    std::istringstream in(make_board(n, n, state.range(1), "*."));
+    HashLife l(in, n, n);
+
+    const long long before = allocations;
+    for (auto _ : state)
+        l.evolve_all();
+    report(state, (long long) n * n, allocations - before);
+}
+
+/**
+ * board sides 16, 128, 1024 and 8192 (2048 for Cell, 8192 x 8192 Cells do not fit in memory twice)
+ * at 10% and 50% live cells
+ */
+void sizes(benchmark::internal::Benchmark* b, int largest) {
+    int n = 16;
+    for (; n <= largest; n *= 8)
+        for (int percent : {10, 50})
+            b->Args({n, percent});
+    if (n / 8 != largest)
+        for (int percent : {10, 50})
+            b->Args({largest, percent});
+}
+
+void small(benchmark::internal::Benchmark* b) { sizes(b, 2048); }
+void large(benchmark::internal::Benchmark* b) { sizes(b, 8192); }
+
+}
+
+BENCHMARK_TEMPLATE(BM_construct, ConwayCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct, FredkinCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct, Cell)->Apply(small)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_evolve_all, ConwayCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_evolve_all, FredkinCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_evolve_all, Cell)->Apply(small)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_print, ConwayCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_print, FredkinCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_print, Cell)->Apply(small)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_iterate, ConwayCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_iterate, FredkinCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_iterate, Cell)->Apply(small)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_rows, ConwayCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_rows, FredkinCell)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_rows, Cell)->Apply(small)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_bitlife_evolve_all)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fredkinlife_evolve_all)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_lutlife_evolve_all)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_streamlife_run)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_tiledlife_evolve)->Apply(large)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hashlife_evolve_all)->Apply(small)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,167 @@
+#include <vector>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+
+#include "BitLife.h"
+
+using namespace std;
+
+// ---------
+// reference
+// ---------
+
+BitLife::reference& BitLife::reference::operator=(const ConwayCell& c) {
+	if (c.is_alive())
+		*word |= mask;
+	else
+		*word &= ~mask;
+	return *this;
+}
+
+BitLife::reference& BitLife::reference::operator=(const reference& rhs) {
+	return *this = ConwayCell(rhs);
+}
+
+BitLife::reference::operator ConwayCell() const {
+	return ConwayCell(is_alive() ? '*' : '.');
+}
+
+ostream& BitLife::reference::print(ostream& out) const {
+	return out << (is_alive() ? '*' : '.');
+}
+
+ostream& operator<<(ostream& out, const BitLife::reference& c) {
+	return c.print(out);
+}
+
+// -------
+// BitLife
+// -------
+
+namespace {
+
+/**
+ * majority of three bit planes, the carry out of a full adder
+ */
+inline uint64_t majority(uint64_t a, uint64_t b, uint64_t c) {
+	return (a & b) | (c & (a ^ b));
+}
+
+}
+
+BitLife::BitLife(istream& in, int h, int w) {
+	width = w;
+	height = h;
+	words = (width + 63) / 64;
+	generation = 0;
+	population = 0;
+
+	board.resize((height + 2) * words, 0);
+
+	int x = 0;
+	int y = 0;
+
+	while (true) {
+		int input = in.get();
+
+		if (input == EOF || (input == '\n' && y == 0))
+			break;
+
+		if (input == '\n') {
+			x++;
+			assert(y == width);
+			y = 0;
+			continue;
+		}
+
+		ConwayCell new_cell((char) input);
+
+		if (new_cell.is_alive())
+			population++;
+
+		at(x, y) = new_cell;
+
+		y++;
+	}
+
+	assert(x == height);
+
+	next_board = board;
+}
+
+void BitLife::print(ostream& out) const {
+	out << "Generation = " << generation << ", Population = " << population << "." << endl;
+	for (int x = 0; x < height; x++) {
+		for (int y = 0; y < width; y++)
+			out << (at(x, y).is_alive() ? '*' : '.');
+
+		out << endl;
+	}
+	out << endl;
+}
+
+void BitLife::evolve_all() {
+	population = 0;
+
+	// keeps the bits past the last column dead
+	const uint64_t last_mask = (width % 64 == 0) ? ~uint64_t(0) : (uint64_t(1) << (width % 64)) - 1;
+
+	for (int x = 1; x < height + 1; x++) {
+		const uint64_t* up = &board[(x - 1) * words];
+		const uint64_t* mid = up + words;
+		const uint64_t* down = mid + words;
+		uint64_t* out = &next_board[x * words];
+
+		for (int k = 0; k < words; k++) {
+			const bool first = k == 0;
+			const bool last = k == words - 1;
+
+			// bit y of each plane is the neighbor in that direction of column y
+			const uint64_t ul = (up[k] << 1) | (first ? 0 : up[k - 1] >> 63);
+			const uint64_t ur = (up[k] >> 1) | (last ? 0 : up[k + 1] << 63);
+			const uint64_t ml = (mid[k] << 1) | (first ? 0 : mid[k - 1] >> 63);
+			const uint64_t mr = (mid[k] >> 1) | (last ? 0 : mid[k + 1] << 63);
+			const uint64_t dl = (down[k] << 1) | (first ? 0 : down[k - 1] >> 63);
+			const uint64_t dr = (down[k] >> 1) | (last ? 0 : down[k + 1] << 63);
+
+			// add each row (weight 1 sums, weight 2 carries)
+			const uint64_t su = ul ^ up[k] ^ ur;
+			const uint64_t cu = majority(ul, up[k], ur);
+			const uint64_t sm = ml ^ mr;
+			const uint64_t cm = ml & mr;
+			const uint64_t sd = dl ^ down[k] ^ dr;
+			const uint64_t cd = majority(dl, down[k], dr);
+
+			// live_neighbors = ones + 2 * (cu + cm + cd + c1)
+			const uint64_t ones = su ^ sm ^ sd;
+			const uint64_t c1 = majority(su, sm, sd);
+			const uint64_t s2 = cu ^ cm ^ cd;
+			const uint64_t c2 = majority(cu, cm, cd);
+
+			// exactly one carry of weight 2 means 2 or 3 live neighbors
+			const uint64_t two_or_three = ~c2 & (s2 ^ c1);
+
+			uint64_t next = two_or_three & (ones | mid[k]);
+			if (last)
+				next &= last_mask;
+
+			out[k] = next;
+			population += __builtin_popcountll(next);
+		}
+	}
+
+	board.swap(next_board);
+	generation++;
+}
+
+BitLife::reference BitLife::at(int x, int y) {
+	assert(y >= 0 && y < width);
+	return reference(&board.at((x + 1) * words + y / 64), y % 64);
+}
+
+ConwayCell BitLife::at(int x, int y) const {
+	assert(y >= 0 && y < width);
+	const bool alive = (board.at((x + 1) * words + y / 64) >> (y % 64)) & 1;
+	return ConwayCell(alive ? '*' : '.');
+}
@@ -0,0 +1,285 @@
+#ifndef BitLife_h
+#define BitLife_h
+
+#include <vector>
+#include <iostream>
+#include <cstdint>
+
+#include "Life.h"
+
+// 	-------------------------------------------------------------------------
+//	Class BitLife is a Game of Life board for ConwayCells packed 64 to a word
+//	-------------------------------------------------------------------------
+class BitLife {
+public:
+
+	// 	-----------------------------------------------------------------
+	//	Nested Class reference, stands in for a ConwayCell& into the board
+	//	-----------------------------------------------------------------
+	class reference {
+		/**
+		 * print the symbol of the referenced cell
+		 * @param out the ostream to write to
+		 * @param c the cell we want to print
+		 * @return the ostream
+		 */
+		friend std::ostream& operator<<(std::ostream& out, const reference& c);
+
+	public:
+
+		/**
+		 * constructor
+		 * @param w the word holding the cell
+		 * @param b the bit of the cell inside w
+		 */
+		reference(uint64_t* w, int b) : word(w), mask(uint64_t(1) << b) {}
+
+		/**
+		 * store a cell in the board
+		 * @param c the cell to store, only its alive state is kept
+		 * @return a reference to this
+		 */
+		reference& operator=(const ConwayCell& c);
+
+		/**
+		 * store the cell referenced by rhs in the board
+		 * @param rhs the cell to copy from
+		 * @return a reference to this
+		 */
+		reference& operator=(const reference& rhs);
+
+		/**
+		 * unpack the referenced cell
+		 * @return a ConwayCell with the same state
+		 */
+		operator ConwayCell() const;
+
+		/**
+		 * is the cell alive or dead?
+		 * @return true if alive, false if dead
+		 */
+		bool is_alive() const { return (*word & mask) != 0; }
+
+		/**
+		 * is the cell a border? the packed board has no border cells
+		 * @return false
+		 */
+		bool is_border() const { return false; }
+
+		/**
+		 * print this cell's symbol
+		 * @param out the ostream to write to
+		 * @return the ostream
+		 */
+		std::ostream& print(std::ostream& out) const;
+
+	private:
+		uint64_t* word;		//the word holding the cell
+		uint64_t mask;		//the bit of the cell inside word
+	};
+
+	/**
+	 * constructor
+	 * @param in the istream to read from
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 */
+	BitLife(std::istream& in, int h, int w);
+
+	/**
+	 * print the board, same format as Life<ConwayCell>::print
+	 * @param out the ostream to write to
+	 */
+	void print(std::ostream& out) const;
+
+	/**
+	 * evolve every cell of the board, 64 cells at a time
+	 */
+	void evolve_all();
+
+	/**
+	 * will retrieve the cell at position (x, y) in the board
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @return a proxy to the cell at position (x,y)
+	 */
+	reference at(int x, int y);
+
+	/**
+	 * const version of at(), will retrieve the cell at position (x, y) in the board
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @return a copy of the cell at position (x,y)
+	 */
+	ConwayCell at(int x, int y) const;
+
+	// 	---------------------------------------------------
+	//	Nested Class iterator, it will iterate over the board
+	//	---------------------------------------------------
+	class iterator {
+	public:
+
+		/**
+		 * constructor
+		 * @param l is the board to iterate over
+		 * @param x_ the row to start at
+		 * @param y_ the column to start at
+		 */
+		iterator(BitLife& l, int x_, int y_) : life(l), x(x_), y(y_) {}
+
+		/**
+		 * operator * will override the * operator for iterator
+		 * @return a proxy to the cell this iterator points to
+		 */
+		reference operator*() const {
+			return life.at(x, y);
+		}
+
+		/**
+		 * operator ++ will iterate to the next cell
+		 * @return a reference to this iterator
+		 */
+		iterator& operator++() {
+			if (++y >= life.width) {
+				x++;
+				y = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator -- will iterate to the previous cell
+		 * @return a reference to this iterator
+		 */
+		iterator& operator--() {
+			if (--y < 0) {
+				x--;
+				y = life.width - 1;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator == will override the == operator for iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator==(const iterator& rhs) const {
+			return x == rhs.x && y == rhs.y && &life == &rhs.life;
+		}
+
+		/**
+		 * operator != will override the != operator for iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator!=(const iterator& rhs) const {
+			return !(*this == rhs);
+		}
+	private:
+		BitLife& life;		//the board that will be iterated over
+		int x;				//current x
+		int y;				//current y
+	};
+
+	// 	---------------------------------------------------------
+	//	Nested Class const_iterator, it will iterate over the board
+	//	---------------------------------------------------------
+	class const_iterator {
+	public:
+
+		/**
+		 * constructor
+		 * @param l is the board to iterate over
+		 * @param x_ the row to start at
+		 * @param y_ the column to start at
+		 */
+		const_iterator(const BitLife& l, int x_, int y_) : life(l), x(x_), y(y_) {}
+
+		/**
+		 * operator * will override the * operator for const_iterator
+		 * @return a copy of the cell this iterator points to
+		 */
+		ConwayCell operator*() const {
+			return life.at(x, y);
+		}
+
+		/**
+		 * operator ++ will iterate to the next cell
+		 * @return a reference to this iterator
+		 */
+		const_iterator& operator++() {
+			if (++y >= life.width) {
+				x++;
+				y = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator -- will iterate to the previous cell
+		 * @return a reference to this iterator
+		 */
+		const_iterator& operator--() {
+			if (--y < 0) {
+				x--;
+				y = life.width - 1;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator == will override the == operator for const_iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator==(const const_iterator& rhs) const {
+			return x == rhs.x && y == rhs.y && &life == &rhs.life;
+		}
+
+		/**
+		 * operator != will override the != operator for const_iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator!=(const const_iterator& rhs) const {
+			return !(*this == rhs);
+		}
+	private:
+		const BitLife& life;	//the board that will be iterated over
+		int x;					//current x
+		int y;					//current y
+	};
+
+	/**
+	 * return the first cell in the board
+	 * @return an iterator to the first cell
+	 */
+	iterator begin() { return iterator(*this, 0, 0); }
+
+	/**
+	 * return the first cell in the board
+	 * @return an iterator to the first cell
+	 */
+	const_iterator begin() const { return const_iterator(*this, 0, 0); }
+
+	/**
+	 * return one past the last cell in the board
+	 * @return an iterator one past the last cell
+	 */
+	iterator end() { return iterator(*this, height, 0); }
+
+	/**
+	 * return one past the last cell in the board
+	 * @return an iterator one past the last cell
+	 */
+	const_iterator end() const { return const_iterator(*this, height, 0); }
+
+private:
+	int height;			//max height
+	int width;			//max width
+	int words;			//words per row, the unused high bits of the last word stay 0
+	std::vector<uint64_t> board;		//rows 0 and height + 1 are always-dead border rows
+	std::vector<uint64_t> next_board;	//the back buffer the next generation is written into
+
+	int generation;			//generation tracker
+	int population;			//population tracker
+};
+
+#endif
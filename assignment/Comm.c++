@@ -0,0 +1,97 @@
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <cassert>
+
+#include "Comm.h"
+
+using namespace std;
+
+// ----------
+// LocalWorld
+// ----------
+
+void LocalWorld::send(int from, int to, int tag, const void* data, size_t size) {
+	const char* bytes = static_cast<const char*>(data);
+	{
+		lock_guard<mutex> l(lock);
+		const Key k = {from, to, tag};
+		mail[k].push_back(vector<char>(bytes, bytes + size));
+	}
+	arrived.notify_all();
+}
+
+vector<char> LocalWorld::receive(int from, int to, int tag) {
+	const Key k = {from, to, tag};
+	unique_lock<mutex> l(lock);
+	arrived.wait(l, [this, &k] {
+		map<Key, deque<vector<char> > >::const_iterator it = mail.find(k);
+		return it != mail.end() && !it->second.empty();
+	});
+
+	deque<vector<char> >& box = mail[k];
+	vector<char> message;
+	message.swap(box.front());
+	box.pop_front();
+	return message;
+}
+
+// ---------
+// LocalComm
+// ---------
+
+LocalComm::Request LocalComm::isend(const void* data, size_t size, int to, int tag) {
+	world.send(rank_, to, tag, data, size);
+	const Request r = {nullptr, size, to, tag};
+	return r;
+}
+
+LocalComm::Request LocalComm::irecv(void* data, size_t size, int from, int tag) {
+	const Request r = {data, size, from, tag};
+	return r;
+}
+
+void LocalComm::wait(Request& r) {
+	if (r.data == nullptr)
+		return;
+
+	const vector<char> message = world.receive(r.from, rank_, r.tag);
+	assert(message.size() == r.size);
+	memcpy(r.data, message.data(), r.size);
+	r.data = nullptr;
+}
+
+long long LocalComm::allreduce_sum(long long v) {
+	// every rank sends its value to rank 0, which sends the sum back
+	if (rank_ != 0) {
+		world.send(rank_, 0, reduce_tag, &v, sizeof(v));
+		const vector<char> sum = world.receive(0, rank_, reduce_tag);
+		memcpy(&v, sum.data(), sizeof(v));
+		return v;
+	}
+
+	for (int r = 1; r < size(); r++) {
+		const vector<char> other = world.receive(r, 0, reduce_tag);
+		long long o;
+		memcpy(&o, other.data(), sizeof(o));
+		v += o;
+	}
+	for (int r = 1; r < size(); r++)
+		world.send(0, r, reduce_tag, &v, sizeof(v));
+	return v;
+}
+
+void LocalComm::gather(const vector<char>& mine, vector<vector<char> >& all) {
+	if (rank_ != 0) {
+		world.send(rank_, 0, gather_tag, mine.data(), mine.size());
+		return;
+	}
+
+	all.resize(size());
+	all[0] = mine;
+	for (int r = 1; r < size(); r++)
+		all[r] = world.receive(r, 0, gather_tag);
+}
@@ -0,0 +1,219 @@
+#ifndef Comm_h
+#define Comm_h
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+#ifdef LIFE_MPI
+#include <mpi.h>
+#endif
+
+// 	-------------------------------------------------------------------------
+//	LocalComm and MPIComm are the communication policies of DistLife<T, Comm>.
+//	A policy names a rank and the number of ranks, sends and receives bytes
+//	without blocking, waits for a request, sums a value over every rank and
+//	gathers a buffer of every rank on rank 0. LocalComm runs every rank in one
+//	process, one thread each, so a distributed board can be tested anywhere;
+//	MPIComm is compiled with -DLIFE_MPI and maps each call onto MPI.
+// 	-------------------------------------------------------------------------
+
+// 	------------------------------------------------------------------------
+//	Class LocalWorld is the mailboxes of the ranks of one process. A message
+//	is copied when it is sent, so a send never waits for its receive.
+// 	------------------------------------------------------------------------
+class LocalWorld {
+public:
+
+	/**
+	 * constructor
+	 * @param n the number of ranks
+	 */
+	explicit LocalWorld(int n) : ranks(n) {}
+
+	/**
+	 * how many ranks are there?
+	 * @return the number of ranks
+	 */
+	int size() const { return ranks; }
+
+	/**
+	 * leave a copy of a message for rank to, messages of the same from, to and tag stay in order
+	 * @param from the sending rank
+	 * @param to the receiving rank
+	 * @param tag the kind of message
+	 * @param data the bytes of the message
+	 * @param size the number of bytes
+	 */
+	void send(int from, int to, int tag, const void* data, std::size_t size);
+
+	/**
+	 * wait for the oldest message from rank from with this tag, and take it
+	 * @param from the sending rank
+	 * @param to the receiving rank
+	 * @param tag the kind of message
+	 * @return the bytes of the message
+	 */
+	std::vector<char> receive(int from, int to, int tag);
+
+	LocalWorld(const LocalWorld&) = delete;
+	LocalWorld& operator=(const LocalWorld&) = delete;
+
+private:
+	struct Key {
+		int from;
+		int to;
+		int tag;
+
+		bool operator<(const Key& rhs) const {
+			return from != rhs.from ? from < rhs.from : to != rhs.to ? to < rhs.to : tag < rhs.tag;
+		}
+	};
+
+	int ranks;											//the number of ranks
+	std::mutex lock;									//guards mail
+	std::condition_variable arrived;					//signaled when a message is left
+	std::map<Key, std::deque<std::vector<char> > > mail;	//the messages not received yet
+};
+
+// 	---------------------------------------------------------------------
+//	Class LocalComm is what one rank of a LocalWorld sees of the others
+// 	---------------------------------------------------------------------
+class LocalComm {
+public:
+	// 	--------------------------------------------------------
+	//	Request is a receive to complete, a send is already done
+	// 	--------------------------------------------------------
+	struct Request {
+		void* data;			//where the message goes, null for a send
+		std::size_t size;	//the size of the message
+		int from;			//the sending rank
+		int tag;			//the kind of message
+	};
+
+	/**
+	 * constructor
+	 * @param w the world this rank is part of
+	 * @param r the rank, 0 to w.size() - 1
+	 */
+	LocalComm(LocalWorld& w, int r) : world(w), rank_(r) {}
+
+	int rank() const { return rank_; }
+	int size() const { return world.size(); }
+
+	/**
+	 * send size bytes to rank to, data can be reused as soon as this returns
+	 * @return a request that is already complete
+	 */
+	Request isend(const void* data, std::size_t size, int to, int tag);
+
+	/**
+	 * receive size bytes from rank from into data, complete once waited for
+	 * @return the request to wait for
+	 */
+	Request irecv(void* data, std::size_t size, int from, int tag);
+
+	/**
+	 * wait for a request to complete
+	 * @param r the request returned by isend or irecv
+	 */
+	void wait(Request& r);
+
+	/**
+	 * the sum of a value over every rank, every rank has to call it
+	 * @param v the value of this rank
+	 * @return the sum, on every rank
+	 */
+	long long allreduce_sum(long long v);
+
+	/**
+	 * gather a buffer of every rank on rank 0, every rank has to call it
+	 * @param mine the buffer of this rank
+	 * @param all the buffer of each rank, in rank order, only filled in on rank 0
+	 */
+	void gather(const std::vector<char>& mine, std::vector<std::vector<char> >& all);
+
+private:
+	static const int reduce_tag = -1;	//the tag of allreduce_sum messages
+	static const int gather_tag = -2;	//the tag of gather messages
+
+	LocalWorld& world;	//the mailboxes
+	int rank_;			//the rank of this Comm
+};
+
+#ifdef LIFE_MPI
+
+// 	----------------------------------------------------------------------
+//	Class MPIComm is a rank of an MPI communicator, MPI_COMM_WORLD if none
+//	is given. MPI_Init and MPI_Finalize are left to the program.
+// 	----------------------------------------------------------------------
+class MPIComm {
+public:
+	typedef MPI_Request Request;
+
+	explicit MPIComm(MPI_Comm c = MPI_COMM_WORLD) : comm(c) {
+		MPI_Comm_rank(comm, &rank_);
+		MPI_Comm_size(comm, &size_);
+	}
+
+	int rank() const { return rank_; }
+	int size() const { return size_; }
+
+	/**
+	 * data has to stay untouched until the request is waited for
+	 */
+	Request isend(const void* data, std::size_t size, int to, int tag) {
+		Request r;
+		MPI_Isend(const_cast<void*>(data), (int) size, MPI_BYTE, to, tag, comm, &r);
+		return r;
+	}
+
+	Request irecv(void* data, std::size_t size, int from, int tag) {
+		Request r;
+		MPI_Irecv(data, (int) size, MPI_BYTE, from, tag, comm, &r);
+		return r;
+	}
+
+	void wait(Request& r) {
+		MPI_Wait(&r, MPI_STATUS_IGNORE);
+	}
+
+	long long allreduce_sum(long long v) {
+		long long sum;
+		MPI_Allreduce(&v, &sum, 1, MPI_LONG_LONG, MPI_SUM, comm);
+		return sum;
+	}
+
+	void gather(const std::vector<char>& mine, std::vector<std::vector<char> >& all) {
+		const int n = mine.size();
+		std::vector<int> sizes(rank_ == 0 ? size_ : 0);
+		MPI_Gather(const_cast<int*>(&n), 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+
+		std::vector<int> offsets(sizes.size());
+		std::vector<char> bytes;
+		if (rank_ == 0) {
+			for (int r = 1; r < size_; r++)
+				offsets[r] = offsets[r - 1] + sizes[r - 1];
+			bytes.resize(offsets.back() + sizes.back());
+		}
+		MPI_Gatherv(const_cast<char*>(mine.data()), n, MPI_BYTE, bytes.data(), sizes.data(), offsets.data(), MPI_BYTE, 0, comm);
+
+		if (rank_ == 0) {
+			all.resize(size_);
+			for (int r = 0; r < size_; r++)
+				all[r].assign(bytes.begin() + offsets[r], bytes.begin() + offsets[r] + sizes[r]);
+		}
+	}
+
+private:
+	MPI_Comm comm;	//the communicator
+	int rank_;		//the rank of this process
+	int size_;		//the number of processes
+};
+
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <cuda_runtime.h>
+
+#include "Device.h"
+
+// ------
+// kernel
+// ------
+
+namespace {
+
+const int tile = CudaDevice::tile;
+
+void check(cudaError_t e) {
+	if (e != cudaSuccess)
+		throw std::runtime_error(std::string("CUDA: ") + cudaGetErrorString(e));
+}
+
+/**
+ * one block per tile of one board, one thread per cell of the tile
+ * the alive bits of the tile and its halo go to shared memory first, the live cells of the block are added to the board's counter
+ */
+template <class Rule>
+__global__ void evolve_tiles(const typename Rule::code* in, typename Rule::code* out, int h, int w, unsigned long long* populations) {
+	const int span = tile + 2;
+	__shared__ unsigned char alive[span * span];
+	__shared__ unsigned int live;
+
+	const int pitch = w + 2;
+	const std::size_t board = (std::size_t) blockIdx.z * (h + 2) * pitch;
+	const int x0 = blockIdx.y * tile;
+	const int y0 = blockIdx.x * tile;
+	const int t = threadIdx.y * tile + threadIdx.x;
+
+	if (t == 0)
+		live = 0;
+	for (int i = t; i < span * span; i += tile * tile) {
+		const int r = x0 + i / span;
+		const int c = y0 + i % span;
+		alive[i] = (r <= h + 1 && c <= w + 1) ? in[board + (std::size_t) r * pitch + c] & 1 : 0;
+	}
+	__syncthreads();
+
+	const int x = x0 + threadIdx.y;
+	const int y = y0 + threadIdx.x;
+	if (x < h && y < w) {
+		const std::size_t i = board + (std::size_t) (x + 1) * pitch + y + 1;
+		const typename Rule::code c = Rule::next(in[i], Rule::count(alive, (threadIdx.y + 1) * span + threadIdx.x + 1, span));
+		out[i] = c;
+		if (c & 1)
+			atomicAdd(&live, 1u);
+	}
+	__syncthreads();
+
+	if (t == 0 && live != 0)
+		atomicAdd(&populations[blockIdx.z], (unsigned long long) live);
+}
+
+}
+
+// ----------
+// CudaDevice
+// ----------
+
+void* CudaDevice::allocate(std::size_t size) {
+	void* p;
+	check(cudaMalloc(&p, size));
+	check(cudaMemset(p, 0, size));
+	return p;
+}
+
+void CudaDevice::release(void* p) {
+	cudaFree(p);
+}
+
+void CudaDevice::upload(void* device, const void* host, std::size_t size) {
+	check(cudaMemcpy(device, host, size, cudaMemcpyHostToDevice));
+}
+
+void CudaDevice::download(void* host, const void* device, std::size_t size) {
+	check(cudaMemcpy(host, device, size, cudaMemcpyDeviceToHost));
+}
+
+void CudaDevice::clear(void* device, std::size_t size) {
+	check(cudaMemset(device, 0, size));
+}
+
+template <class Rule>
+void CudaDevice::evolve(const typename Rule::code* in, typename Rule::code* out, int boards, int h, int w, unsigned long long* populations) {
+	// at most 65535 boards to a launch along z
+	const int per_launch = 65535;
+	for (int b = 0; b < boards; b += per_launch) {
+		const std::size_t offset = (std::size_t) b * (h + 2) * (w + 2);
+		const dim3 grid((w + tile - 1) / tile, (h + tile - 1) / tile, std::min(per_launch, boards - b));
+		evolve_tiles<Rule><<<grid, dim3(tile, tile)>>>(in + offset, out + offset, h, w, populations + b);
+		check(cudaGetLastError());
+	}
+}
+
+template void CudaDevice::evolve<DeviceRule<ConwayCell> >(const DeviceRule<ConwayCell>::code*, DeviceRule<ConwayCell>::code*, int, int, int, unsigned long long*);
+template void CudaDevice::evolve<DeviceRule<FredkinCell> >(const DeviceRule<FredkinCell>::code*, DeviceRule<FredkinCell>::code*, int, int, int, unsigned long long*);
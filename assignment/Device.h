@@ -0,0 +1,144 @@
+#ifndef Device_h
+#define Device_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#ifdef __CUDACC__
+#define LIFE_HOST_DEVICE __host__ __device__
+#else
+#define LIFE_HOST_DEVICE
+#endif
+
+class ConwayCell;
+class FredkinCell;
+
+// 	-------------------------------------------------------------------------
+//	DeviceRule<T> is the rule of T on the encoding CellCodec<T> gives a cell,
+//	so a device can evolve boards of T without knowing T. Bit 0 of a code is
+//	always the alive bit, and the dead code is 0, the code of the border ring.
+// 	-------------------------------------------------------------------------
+template <class T>
+struct DeviceRule;
+
+template <>
+struct DeviceRule<ConwayCell> {
+	typedef std::uint8_t code;
+
+	/**
+	 * the 8 neighbors of cell i of a tile of alive bits
+	 */
+	LIFE_HOST_DEVICE static int count(const unsigned char* tile, int i, int stride) {
+		return tile[i - stride - 1] + tile[i - stride] + tile[i - stride + 1] +
+		       tile[i - 1] + tile[i + 1] +
+		       tile[i + stride - 1] + tile[i + stride] + tile[i + stride + 1];
+	}
+
+	LIFE_HOST_DEVICE static code next(code c, int live_neighbors) {
+		return live_neighbors == 3 || (c && live_neighbors == 2);
+	}
+};
+
+template <>
+struct DeviceRule<FredkinCell> {
+	typedef std::uint32_t code;	// age << 1 | alive
+
+	/**
+	 * the 4 orthogonal neighbors of cell i of a tile of alive bits
+	 */
+	LIFE_HOST_DEVICE static int count(const unsigned char* tile, int i, int stride) {
+		return tile[i - stride] + tile[i - 1] + tile[i + 1] + tile[i + stride];
+	}
+
+	LIFE_HOST_DEVICE static code next(code c, int live_neighbors) {
+		// alive on 1 or 3, a cell that stays alive gets one generation older
+		const code lives = live_neighbors & 1;
+		return (c & lives) ? (c + 2) : ((c & ~1u) | lives);
+	}
+};
+
+// 	-------------------------------------------------------------------------
+//	HostDevice and CudaDevice are the devices of DeviceLife<T, Device>. A
+//	device owns memory the host can only reach through upload and download,
+//	and evolves every board of a batch one generation in one call. A batch is
+//	the boards one after the other, each (h + 2) x (w + 2) codes with a ring
+//	of dead codes the device never writes. The kernel works in tiles of
+//	tile x tile cells: the alive bits of a tile and its halo are loaded into
+//	fast memory once, then every cell of the tile is counted from there.
+//	HostDevice runs that kernel on the calling thread, so a batch can be
+//	tested anywhere; CudaDevice is compiled from Device.cu with -DLIFE_CUDA.
+// 	-------------------------------------------------------------------------
+class HostDevice {
+public:
+	static const int tile = 16;		//the side of a tile
+
+	void* allocate(std::size_t size) { return new char[size](); }
+	void release(void* p) { delete[] static_cast<char*>(p); }
+	void upload(void* device, const void* host, std::size_t size) { std::memcpy(device, host, size); }
+	void download(void* host, const void* device, std::size_t size) { std::memcpy(host, device, size); }
+	void clear(void* device, std::size_t size) { std::memset(device, 0, size); }
+
+	/**
+	 * evolve every board of a batch one generation
+	 * @param in the batch, boards x (h + 2) x (w + 2) codes
+	 * @param out where the next generation goes, the same layout, its ring is left as it is
+	 * @param boards the number of boards
+	 * @param h is the height of a board
+	 * @param w is the width of a board
+	 * @param populations one counter per board, zeroed by the caller, the live cells are added to it
+	 */
+	template <class Rule>
+	void evolve(const typename Rule::code* in, typename Rule::code* out, int boards, int h, int w, unsigned long long* populations) {
+		const int pitch = w + 2;
+		const int span = tile + 2;
+		unsigned char alive[span * span];	//the tile and its halo, the shared memory of a CUDA block
+
+		for (int b = 0; b < boards; b++) {
+			const typename Rule::code* board = in + (std::size_t) b * (h + 2) * pitch;
+			typename Rule::code* next = out + (std::size_t) b * (h + 2) * pitch;
+
+			for (int x0 = 0; x0 < h; x0 += tile)
+				for (int y0 = 0; y0 < w; y0 += tile) {
+					// padded row x0 + r is row x0 + r - 1 of the board
+					for (int r = 0; r < span; r++)
+						for (int c = 0; c < span; c++)
+							alive[r * span + c] = (x0 + r <= h + 1 && y0 + c <= w + 1) ? board[(x0 + r) * pitch + y0 + c] & 1 : 0;
+
+					unsigned long long live = 0;
+					for (int r = 0; r < tile && x0 + r < h; r++)
+						for (int c = 0; c < tile && y0 + c < w; c++) {
+							const std::size_t i = (std::size_t) (x0 + r + 1) * pitch + y0 + c + 1;
+							next[i] = Rule::next(board[i], Rule::count(alive, (r + 1) * span + c + 1, span));
+							live += next[i] & 1;
+						}
+					populations[b] += live;
+				}
+		}
+	}
+};
+
+#ifdef LIFE_CUDA
+
+class CudaDevice {
+public:
+	static const int tile = 16;		//the side of a tile, one thread per cell
+
+	void* allocate(std::size_t size);
+	void release(void* p);
+	void upload(void* device, const void* host, std::size_t size);
+	void download(void* host, const void* device, std::size_t size);
+	void clear(void* device, std::size_t size);
+
+	/**
+	 * launch one block of tile x tile threads per tile of every board, boards along the z axis of the grid
+	 * @throws std::runtime_error if the launch fails
+	 */
+	template <class Rule>
+	void evolve(const typename Rule::code* in, typename Rule::code* out, int boards, int h, int w, unsigned long long* populations);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef DeviceLife_h
+#define DeviceLife_h
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+
+#include "Device.h"
+#include "Life.h"
+
+// 	-------------------------------------------------------------------------
+//	Class template DeviceLife is a batch of boards of T of the same size that
+//	live on a Device. Every evolve_all evolves all of them one generation in
+//	one call to the device, and the boards stay there between generations;
+//	they are only copied back, all at once, the first time print(), at() or
+//	population() needs them after a generation. Generation and population
+//	mean what they mean for Life<T>.
+// 	-------------------------------------------------------------------------
+template <class T, class Device = HostDevice>
+class DeviceLife {
+public:
+	typedef typename DeviceRule<T>::code code;
+
+	/**
+	 * constructor, reads n boards one after the other, each in the format of Life<T>(std::istream&, int, int)
+	 * @param in the istream to read from
+	 * @param n the number of boards
+	 * @param h is the height of every board
+	 * @param w is the width of every board
+	 */
+	DeviceLife(std::istream& in, int n, int h, int w) :
+			boards(n), height(h), width(w), generation_(0), cells((std::size_t) n * (h + 2) * (w + 2), 0), populations(n), stale(false) {
+		for (int b = 0; b < n; b++) {
+			const Life<T> l(in, h, w);
+			for (int x = 0; x < h; x++)
+				for (int y = 0; y < w; y++) {
+					const T& cell = l.at(x, y);
+					cells[index(b, x, y)] = CellCodec<T>::encode(cell);
+					populations[b] += cell.is_alive();
+				}
+		}
+
+		front = static_cast<code*>(device.allocate(cells.size() * sizeof(code)));
+		back = static_cast<code*>(device.allocate(cells.size() * sizeof(code)));
+		counters = static_cast<unsigned long long*>(device.allocate(n * sizeof(unsigned long long)));
+		device.upload(front, cells.data(), cells.size() * sizeof(code));
+		device.upload(back, cells.data(), cells.size() * sizeof(code));
+	}
+
+	/**
+	 * destructor, frees the device memory
+	 */
+	~DeviceLife() {
+		device.release(front);
+		device.release(back);
+		device.release(counters);
+	}
+
+	DeviceLife(const DeviceLife&) = delete;
+	DeviceLife& operator=(const DeviceLife&) = delete;
+
+	/**
+	 * evolve every board one generation, nothing is copied back
+	 */
+	void evolve_all() {
+		device.clear(counters, boards * sizeof(unsigned long long));
+		device.template evolve<DeviceRule<T> >(front, back, boards, height, width, counters);
+		std::swap(front, back);
+		generation_++;
+		stale = true;
+	}
+
+	/**
+	 * evolve every board n generations, nothing is copied back
+	 * @param n the number of generations
+	 */
+	void evolve(int n) {
+		for (int i = 0; i < n; i++)
+			evolve_all();
+	}
+
+	/**
+	 * print board b, in the format of Life<T>::print
+	 * @param b the board, 0 to size() - 1
+	 * @param out the ostream to write to
+	 */
+	void print(int b, std::ostream& out) {
+		fetch();
+		std::string text = "Generation = " + std::to_string(generation_) + ", Population = " + std::to_string(populations[b]) + ".\n";
+		for (int x = 0; x < height; x++) {
+			for (int y = 0; y < width; y++)
+				text += CellCodec<T>::decode(cells[index(b, x, y)]).symbol();
+			text += '\n';
+		}
+		text += '\n';
+		out.write(text.data(), text.size());
+	}
+
+	/**
+	 * a copy of the cell at position (x, y) of board b
+	 * @param b the board
+	 * @param x the row
+	 * @param y the column
+	 * @return the cell
+	 */
+	T at(int b, int x, int y) {
+		assert(b >= 0 && b < boards && x >= 0 && x < height && y >= 0 && y < width);
+		fetch();
+		return CellCodec<T>::decode(cells[index(b, x, y)]);
+	}
+
+	/**
+	 * how many cells of board b are alive?
+	 * @param b the board
+	 * @return the population
+	 */
+	long long population(int b) {
+		fetch();
+		return populations[b];
+	}
+
+	/**
+	 * what generation are the boards at?
+	 * @return the generation
+	 */
+	int generation() const { return generation_; }
+
+	/**
+	 * how many boards are in the batch?
+	 * @return the number of boards
+	 */
+	int size() const { return boards; }
+
+private:
+	/**
+	 * copy the boards and their populations back, once per generation
+	 */
+	void fetch() {
+		if (!stale)
+			return;
+		device.download(cells.data(), front, cells.size() * sizeof(code));
+		device.download(populations.data(), counters, boards * sizeof(unsigned long long));
+		stale = false;
+	}
+
+	std::size_t index(int b, int x, int y) const {
+		return ((std::size_t) b * (height + 2) + x + 1) * (width + 2) + y + 1;
+	}
+
+	Device device;		//where the boards live
+
+	int boards;			//the number of boards
+	int height;			//height of every board
+	int width;			//width of every board
+	int generation_;	//generation tracker
+
+	std::vector<code> cells;						//the host copy of the boards, with their rings
+	std::vector<unsigned long long> populations;	//the host copy of the population of each board
+	bool stale;										//the boards evolved since they were copied back
+
+	code* front;						//the current generation, on the device
+	code* back;							//the next generation, on the device
+	unsigned long long* counters;		//the population of each board, on the device
+};
+
+#endif
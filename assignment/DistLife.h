@@ -0,0 +1,327 @@
+#ifndef DistLife_h
+#define DistLife_h
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+
+#include "Comm.h"
+#include "Life.h"
+
+// 	-------------------------------------------------------------------------
+//	Class template DistLife splits a board of T into a grid of blocks, one per
+//	rank of Comm, for boards too big for one process. Each rank keeps its
+//	block and the alive plane of the block with a ring of halo cells, the
+//	edges of its neighbors. A generation sends the edges without blocking,
+//	evolves the interior of the block while they travel, then evolves the
+//	edges once the halo is in. Cells outside the board are dead, as with
+//	Life<T>. Only the cells NeighborKernel<T> counts are supported.
+// 	-------------------------------------------------------------------------
+template <class T, class Comm>
+class DistLife {
+	static_assert(NeighborKernel<T>::dense, "DistLife exchanges the alive plane, T has to be counted by NeighborKernel<T>");
+
+public:
+
+	/**
+	 * constructor, every rank of c has to call it, each rank decodes its own block only
+	 * @param c this rank and the way to reach the others
+	 * @param data the text of the whole board, the format Life(const char*, std::size_t, int, int) reads
+	 * @param size the number of bytes in data
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 */
+	DistLife(Comm& c, const char* data, std::size_t size, int h, int w) :
+			comm(c), height(h), width(w), generation_(0) {
+		grid(comm.size(), h, w, grid_rows, grid_cols);
+		grid_row = comm.rank() / grid_cols;
+		grid_col = comm.rank() % grid_cols;
+		x_begin = grid_row * h / grid_rows;
+		x_end = (grid_row + 1) * h / grid_rows;
+		y_begin = grid_col * w / grid_cols;
+		y_end = (grid_col + 1) * w / grid_cols;
+		rows = x_end - x_begin;
+		cols = y_end - y_begin;
+		assert(rows > 0 && cols > 0);
+
+		const int stride = cols + 2;
+		alive.assign((rows + 2) * stride, 0);
+		next_alive = alive;
+		counts.resize(cols);
+
+		std::vector<T> prototypes;			//one cell per distinct glyph
+		std::vector<int> slot(256, -1);		//the prototype of each glyph, -1 until it is seen
+		long long live = 0;
+
+		cells.reserve(rows * cols);
+		for (int x = x_begin; x < x_end; x++) {
+			assert((x + 1) * (std::size_t) (w + 1) <= size);
+			const char* row = data + x * (std::size_t) (w + 1);
+			assert(row[w] == '\n');
+
+			for (int y = y_begin; y < y_end; y++) {
+				const unsigned char glyph = row[y];
+				if (slot[glyph] < 0) {
+					slot[glyph] = prototypes.size();
+					prototypes.push_back(T((char) glyph));
+				}
+
+				cells.push_back(prototypes[slot[glyph]]);
+				alive[(x - x_begin + 1) * stride + y - y_begin + 1] = cells.back().is_alive();
+				live += cells.back().is_alive();
+			}
+		}
+		next_cells = cells;
+
+		// the rank on each side, -1 past the edge of the board
+		const int dx[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+		const int dy[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+		const std::size_t lengths[8] = {(std::size_t) cols, (std::size_t) cols, (std::size_t) rows, (std::size_t) rows, 1, 1, 1, 1};
+		for (int d = 0; d < 8; d++) {
+			const int r = grid_row + dx[d];
+			const int k = grid_col + dy[d];
+			neighbor[d] = (r >= 0 && r < grid_rows && k >= 0 && k < grid_cols) ? r * grid_cols + k : -1;
+			outgoing[d].resize(lengths[d]);
+			incoming[d].resize(lengths[d]);
+		}
+
+		population_ = comm.allreduce_sum(live);
+	}
+
+	/**
+	 * evolve the whole board one generation, every rank has to call it
+	 * the population is summed over every rank at the end
+	 */
+	void evolve_all() {
+		std::vector<typename Comm::Request> receives;
+		std::vector<typename Comm::Request> sends;
+
+		// the halo comes in on side d from the neighbor that sends its opposite edge
+		pack();
+		for (int d = 0; d < 8; d++)
+			if (neighbor[d] >= 0) {
+				receives.push_back(comm.irecv(incoming[d].data(), incoming[d].size(), neighbor[d], opposite(d)));
+				sends.push_back(comm.isend(outgoing[d].data(), outgoing[d].size(), neighbor[d], d));
+			}
+
+		// the interior needs nothing from the other ranks
+		long long live = 0;
+		for (int x = 2; x < rows; x++)
+			live += evolve_row(x, 2, cols - 1);
+
+		for (typename Comm::Request& r : receives)
+			comm.wait(r);
+		unpack();
+
+		// the outer rows and columns read the halo
+		live += evolve_row(1, 1, cols);
+		if (rows > 1)
+			live += evolve_row(rows, 1, cols);
+		for (int x = 2; x < rows; x++) {
+			live += evolve_row(x, 1, 1);
+			if (cols > 1)
+				live += evolve_row(x, cols, cols);
+		}
+
+		for (typename Comm::Request& r : sends)
+			comm.wait(r);
+
+		cells.swap(next_cells);
+		alive.swap(next_alive);
+		population_ = comm.allreduce_sum(live);
+		generation_++;
+	}
+
+	/**
+	 * print the whole board, in the format of Life<T>::print, every rank has to call it
+	 * the blocks are gathered on rank 0, which is the only one that writes
+	 * @param out the ostream rank 0 writes to
+	 */
+	void print(std::ostream& out) const {
+		std::vector<char> mine;
+		mine.reserve(rows * cols);
+		for (const T& c : cells)
+			mine.push_back(c.symbol());
+
+		std::vector<std::vector<char> > blocks;
+		comm.gather(mine, blocks);
+		if (comm.rank() != 0)
+			return;
+
+		std::string text = "Generation = " + std::to_string(generation_) + ", Population = " + std::to_string(population_) + ".\n";
+		const std::size_t header = text.size();
+		text.resize(header + (std::size_t) height * (width + 1), '\n');
+
+		for (int r = 0; r < grid_rows; r++)
+			for (int k = 0; k < grid_cols; k++) {
+				const std::vector<char>& block = blocks[r * grid_cols + k];
+				const int x0 = r * height / grid_rows;
+				const int y0 = k * width / grid_cols;
+				const int w = (k + 1) * width / grid_cols - y0;
+				for (int x = x0; x < (r + 1) * height / grid_rows; x++)
+					std::copy(block.begin() + (x - x0) * w, block.begin() + (x - x0 + 1) * w, text.begin() + header + x * (width + 1) + y0);
+			}
+
+		text += '\n';
+		out.write(text.data(), text.size());
+	}
+
+	/**
+	 * the cell at position (x, y) of the board, which has to be in the block of this rank
+	 * @param x the row, between row_begin() and row_end()
+	 * @param y the column, between col_begin() and col_end()
+	 * @return the cell at position (x, y)
+	 */
+	const T& at(int x, int y) const {
+		assert(x >= x_begin && x < x_end && y >= y_begin && y < y_end);
+		return cells[(x - x_begin) * cols + y - y_begin];
+	}
+
+	int row_begin() const { return x_begin; }
+	int row_end() const { return x_end; }
+	int col_begin() const { return y_begin; }
+	int col_end() const { return y_end; }
+
+	/**
+	 * how many cells are alive on the whole board?
+	 * @return the population, the same on every rank
+	 */
+	long long population() const { return population_; }
+
+	/**
+	 * what generation is the board at?
+	 * @return the generation
+	 */
+	int generation() const { return generation_; }
+
+	/**
+	 * the grid of blocks of a board, the one with the smallest halo that has a row and a column for every block
+	 * @param ranks the number of blocks
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 * @param grid_rows set to the number of rows of blocks
+	 * @param grid_cols set to the number of columns of blocks
+	 */
+	static void grid(int ranks, int h, int w, int& grid_rows, int& grid_cols) {
+		grid_rows = 0;
+		long long best = 0;
+		for (int r = 1; r <= ranks; r++) {
+			const int k = ranks / r;
+			if (r * k != ranks || r > h || k > w)
+				continue;
+
+			const long long halo = (long long) r * w + (long long) k * h;
+			if (grid_rows == 0 || halo < best) {
+				best = halo;
+				grid_rows = r;
+			}
+		}
+		assert(grid_rows != 0);
+		grid_cols = ranks / grid_rows;
+	}
+
+private:
+	enum { UP, DOWN, LEFT, RIGHT, UP_LEFT, UP_RIGHT, DOWN_LEFT, DOWN_RIGHT };
+
+	static int opposite(int d) {
+		return d < 4 ? d ^ 1 : 11 - d;
+	}
+
+	/**
+	 * copy the edges of the alive plane into the outgoing buffers
+	 */
+	void pack() {
+		const int stride = cols + 2;
+		std::copy(&alive[stride + 1], &alive[stride + 1] + cols, outgoing[UP].begin());
+		std::copy(&alive[rows * stride + 1], &alive[rows * stride + 1] + cols, outgoing[DOWN].begin());
+		for (int x = 1; x <= rows; x++) {
+			outgoing[LEFT][x - 1] = alive[x * stride + 1];
+			outgoing[RIGHT][x - 1] = alive[x * stride + cols];
+		}
+		outgoing[UP_LEFT][0] = alive[stride + 1];
+		outgoing[UP_RIGHT][0] = alive[stride + cols];
+		outgoing[DOWN_LEFT][0] = alive[rows * stride + 1];
+		outgoing[DOWN_RIGHT][0] = alive[rows * stride + cols];
+	}
+
+	/**
+	 * copy the incoming buffers into the ring of the alive plane, the ring stays dead past the edge of the board
+	 */
+	void unpack() {
+		const int stride = cols + 2;
+		if (neighbor[UP] >= 0)
+			std::copy(incoming[UP].begin(), incoming[UP].end(), &alive[1]);
+		if (neighbor[DOWN] >= 0)
+			std::copy(incoming[DOWN].begin(), incoming[DOWN].end(), &alive[(rows + 1) * stride + 1]);
+		for (int x = 1; x <= rows; x++) {
+			if (neighbor[LEFT] >= 0)
+				alive[x * stride] = incoming[LEFT][x - 1];
+			if (neighbor[RIGHT] >= 0)
+				alive[x * stride + cols + 1] = incoming[RIGHT][x - 1];
+		}
+		if (neighbor[UP_LEFT] >= 0)
+			alive[0] = incoming[UP_LEFT][0];
+		if (neighbor[UP_RIGHT] >= 0)
+			alive[cols + 1] = incoming[UP_RIGHT][0];
+		if (neighbor[DOWN_LEFT] >= 0)
+			alive[(rows + 1) * stride] = incoming[DOWN_LEFT][0];
+		if (neighbor[DOWN_RIGHT] >= 0)
+			alive[(rows + 1) * stride + cols + 1] = incoming[DOWN_RIGHT][0];
+	}
+
+	/**
+	 * evolve columns [c_begin, c_end] of row x of the block, counted from 1 like the alive plane
+	 * @return the population of the evolved cells
+	 */
+	long long evolve_row(int x, int c_begin, int c_end) {
+		const int stride = cols + 2;
+		const int n = c_end - c_begin + 1;
+		if (n <= 0)
+			return 0;
+
+		const unsigned char* mid = &alive[x * stride + c_begin];
+		NeighborKernel<T>::count(mid - stride, mid, mid + stride, &counts[0], n);
+
+		long long live = 0;
+		for (int i = 0; i < n; i++) {
+			const int c = (x - 1) * cols + c_begin - 1 + i;
+			const T new_cell = cells[c] + (int) counts[i];
+			next_alive[x * stride + c_begin + i] = new_cell.is_alive();
+			live += new_cell.is_alive();
+			next_cells[c] = new_cell;
+		}
+		return live;
+	}
+
+	Comm& comm;					//this rank and the others
+
+	int height;					//height of the whole board
+	int width;					//width of the whole board
+	int grid_rows;				//the number of rows of blocks
+	int grid_cols;				//the number of columns of blocks
+	int grid_row;				//the row of the block of this rank
+	int grid_col;				//the column of the block of this rank
+	int x_begin;				//the first row of the block
+	int x_end;					//one past the last row of the block
+	int y_begin;				//the first column of the block
+	int y_end;					//one past the last column of the block
+	int rows;					//the height of the block
+	int cols;					//the width of the block
+
+	std::vector<T> cells;						//the block, row by row
+	std::vector<T> next_cells;					//the back buffer of the block
+	std::vector<unsigned char> alive;			//1 if alive, (rows + 2) x (cols + 2) with the halo around the block
+	std::vector<unsigned char> next_alive;		//the alive plane of the back buffer
+	std::vector<unsigned char> counts;			//the neighbor counts of one row
+
+	int neighbor[8];							//the rank on each side, -1 past the edge of the board
+	std::vector<unsigned char> outgoing[8];		//the edge sent to each side
+	std::vector<unsigned char> incoming[8];		//the halo received from each side
+
+	long long population_;		//population of the whole board
+	int generation_;			//generation tracker
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+
+#include "FredkinLife.h"
+#include "NeighborCount.h"
+
+using namespace std;
+
+// -----------
+// FredkinLife
+// -----------
+
+namespace {
+
+/**
+ * the symbol of a packed cell, the one FredkinCell::symbol returns
+ */
+inline char symbol(uint8_t c) {
+	if (!(c & 1))
+		return '-';
+	return (c >> 1) < 10 ? '0' + (c >> 1) : '+';
+}
+
+}
+
+const int FredkinLife::max_age;
+
+FredkinLife::FredkinLife(istream& in, int h, int w) : height(h), width(w), generation_(0), population_(0) {
+	board.resize((height + 2) * (width + 2), 0);
+
+	int x = 0;
+	int y = 0;
+
+	while (true) {
+		int input = in.get();
+
+		if (input == EOF || (input == '\n' && y == 0))
+			break;
+
+		if (input == '\n') {
+			x++;
+			assert(y == width);
+			y = 0;
+			continue;
+		}
+
+		const FredkinCell new_cell((char) input);
+		const int age = new_cell.age() < max_age ? new_cell.age() : max_age;
+
+		population_ += new_cell.is_alive();
+		board[(x + 1) * (width + 2) + y + 1] = age << 1 | new_cell.is_alive();
+
+		y++;
+	}
+
+	assert(x == height);
+
+	next_board = board;
+}
+
+void FredkinLife::print(ostream& out) const {
+	string text = "Generation = " + to_string(generation_) + ", Population = " + to_string(population_) + ".\n";
+	const size_t header = text.size();
+
+	text.resize(header + (std::size_t) height * (width + 1) + 1, '\n');
+	char* p = &text[header];
+	for (int x = 1; x < height + 1; x++, p++) {
+		const uint8_t* row = &board[x * (width + 2) + 1];
+		for (int y = 0; y < width; y++)
+			*p++ = symbol(row[y]);
+	}
+
+	out.write(text.data(), text.size());
+}
+
+void FredkinLife::evolve_all() {
+	const int stride = width + 2;
+	population_ = 0;
+
+	for (int x = 1; x < height + 1; x++) {
+		const uint8_t* mid = &board[x * stride + 1];
+		uint8_t* row = &next_board[x * stride + 1];
+		fredkin_step(mid - stride, mid, mid + stride, row, width);
+
+		for (int y = 0; y < width; y++)
+			population_ += row[y] & 1;
+	}
+
+	board.swap(next_board);
+	generation_++;
+}
+
+void FredkinLife::evolve(int n) {
+	for (int i = 0; i < n; i++)
+		evolve_all();
+}
+
+FredkinCell FredkinLife::at(int x, int y) const {
+	assert(x >= 0 && x < height && y >= 0 && y < width);
+	const uint8_t c = board[(x + 1) * (width + 2) + y + 1];
+	return FredkinCell(c >> 1, (c & 1) != 0);
+}
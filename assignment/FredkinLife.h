@@ -0,0 +1,81 @@
+#ifndef FredkinLife_h
+#define FredkinLife_h
+
+#include <vector>
+#include <iostream>
+#include <cstdint>
+
+#include "Life.h"
+
+// 	-------------------------------------------------------------------------
+//	Class FredkinLife is a Game of Life board for FredkinCells packed one to a
+//	byte, the alive flag in bit 0 and the age in bits 1 to 7. The age stops
+//	at 127, past 9 a live cell prints as + whatever its age, so the output is
+//	the same as the one of Life<FredkinCell>. A generation is a row at a time
+//	of fredkin_step, the vectorized kernel of NeighborCount.h, with no cell
+//	ever built.
+// 	-------------------------------------------------------------------------
+class FredkinLife {
+public:
+
+	/**
+	 * constructor
+	 * @param in the istream to read from, the same text Life<FredkinCell> reads
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 */
+	FredkinLife(std::istream& in, int h, int w);
+
+	/**
+	 * print the board, same format as Life<FredkinCell>::print
+	 * @param out the ostream to write to
+	 */
+	void print(std::ostream& out) const;
+
+	/**
+	 * evolve every cell of the board
+	 */
+	void evolve_all();
+
+	/**
+	 * evolve the board n generations
+	 * @param n the number of generations
+	 */
+	void evolve(int n);
+
+	/**
+	 * will retrieve the cell at position (x, y) in the board
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @return a copy of the cell at position (x,y), its age is at most 127
+	 */
+	FredkinCell at(int x, int y) const;
+
+	/**
+	 * how many cells are alive?
+	 * @return the population
+	 */
+	int population() const { return population_; }
+
+	/**
+	 * what generation is the board at?
+	 * @return the generation
+	 */
+	int generation() const { return generation_; }
+
+	/**
+	 * the oldest age a cell keeps
+	 */
+	static const int max_age = 127;
+
+private:
+	int height;			//max height
+	int width;			//max width
+	std::vector<std::uint8_t> board;		//(height + 2) rows of (width + 2), the ring is always dead
+	std::vector<std::uint8_t> next_board;	//the back buffer the next generation is written into
+
+	int generation_;	//generation tracker
+	int population_;	//population tracker
+};
+
+#endif
@@ -0,0 +1,288 @@
+#include <deque>
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+
+#include "HashLife.h"
+
+using namespace std;
+
+// --------
+// HashLife
+// --------
+
+size_t HashLife::KeyHash::operator()(const Key& k) const {
+	hash<const void*> h;
+	size_t seed = h(k.nw);
+	seed ^= h(k.ne) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	seed ^= h(k.sw) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	seed ^= h(k.se) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	return seed;
+}
+
+HashLife::HashLife(istream& in, int h, int w) : step(-1), height(h), width(w), generation_(0) {
+	const Node leaf = {nullptr, nullptr, nullptr, nullptr, 0, 0, nullptr};
+	storage.push_back(leaf);
+	dead = &storage.back();
+	storage.push_back(leaf);
+	storage.back().population = 1;
+	live = &storage.back();
+
+	// the window is the bottom-right quadrant of the root
+	int level = 3;
+	while ((1LL << (level - 1)) < max(h, w))
+		level++;
+	root = empty(level);
+
+	const long long half = 1LL << (level - 1);
+	int x = 0;
+	int y = 0;
+
+	while (true) {
+		int input = in.get();
+
+		if (input == EOF || (input == '\n' && y == 0))
+			break;
+
+		if (input == '\n') {
+			x++;
+			assert(y == width);
+			y = 0;
+			continue;
+		}
+
+		if (ConwayCell((char) input).is_alive())
+			root = set(root, x + half, y + half, true);
+
+		y++;
+	}
+
+	assert(x == height);
+}
+
+const HashLife::Node* HashLife::join(const Node* nw, const Node* ne, const Node* sw, const Node* se) {
+	const Key k = {nw, ne, sw, se};
+	unordered_map<Key, const Node*, KeyHash>::const_iterator it = table.find(k);
+	if (it != table.end())
+		return it->second;
+
+	const Node n = {nw, ne, sw, se, nw->level + 1, nw->population + ne->population + sw->population + se->population, nullptr};
+	storage.push_back(n);
+	table[k] = &storage.back();
+	return &storage.back();
+}
+
+const HashLife::Node* HashLife::empty(int level) {
+	if (empties.empty())
+		empties.push_back(dead);
+	while ((int) empties.size() <= level) {
+		const Node* e = empties.back();
+		empties.push_back(join(e, e, e, e));
+	}
+	return empties[level];
+}
+
+const HashLife::Node* HashLife::expand(const Node* n) {
+	const Node* e = empty(n->level - 1);
+	return join(join(e, e, e, n->nw), join(e, e, n->ne, e),
+	            join(e, n->sw, e, e), join(n->se, e, e, e));
+}
+
+const HashLife::Node* HashLife::centre(const Node* n) {
+	return join(n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+}
+
+const HashLife::Node* HashLife::advance_base(const Node* n) {
+	// the 16 cells of the 4x4 square, row by row
+	int cells[4][4];
+	const Node* quadrants[2][2] = {{n->nw, n->ne}, {n->sw, n->se}};
+	for (int qx = 0; qx < 2; qx++)
+		for (int qy = 0; qy < 2; qy++) {
+			const Node* q = quadrants[qx][qy];
+			cells[2 * qx][2 * qy] = q->nw->population;
+			cells[2 * qx][2 * qy + 1] = q->ne->population;
+			cells[2 * qx + 1][2 * qy] = q->sw->population;
+			cells[2 * qx + 1][2 * qy + 1] = q->se->population;
+		}
+
+	const Node* next[2][2];
+	for (int x = 1; x < 3; x++)
+		for (int y = 1; y < 3; y++) {
+			int live_neighbors = 0;
+			for (int dx = -1; dx <= 1; dx++)
+				for (int dy = -1; dy <= 1; dy++)
+					if (dx != 0 || dy != 0)
+						live_neighbors += cells[x + dx][y + dy];
+
+			const ConwayCell c = ConwayCell(cells[x][y] ? '*' : '.') + live_neighbors;
+			next[x - 1][y - 1] = c.is_alive() ? live : dead;
+		}
+
+	return join(next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+const HashLife::Node* HashLife::advance(const Node* n) {
+	if (n->result != nullptr)
+		return n->result;
+
+	if (n->population == 0)
+		return n->result = n->nw;
+
+	if (n->level == 2)
+		return n->result = advance_base(n);
+
+	// the nine overlapping squares of half the size
+	const Node* n00 = n->nw;
+	const Node* n01 = join(n->nw->ne, n->ne->nw, n->nw->se, n->ne->sw);
+	const Node* n02 = n->ne;
+	const Node* n10 = join(n->nw->sw, n->nw->se, n->sw->nw, n->sw->ne);
+	const Node* n11 = centre(n);
+	const Node* n12 = join(n->ne->sw, n->ne->se, n->se->nw, n->se->ne);
+	const Node* n20 = n->sw;
+	const Node* n21 = join(n->sw->ne, n->se->nw, n->sw->se, n->se->sw);
+	const Node* n22 = n->se;
+
+	const Node* r00;
+	const Node* r01;
+	const Node* r02;
+	const Node* r10;
+	const Node* r11;
+	const Node* r12;
+	const Node* r20;
+	const Node* r21;
+	const Node* r22;
+
+	if (step >= n->level - 2) {
+		// full speed, both halves of the step advance 2^(level - 3) generations
+		r00 = advance(n00); r01 = advance(n01); r02 = advance(n02);
+		r10 = advance(n10); r11 = advance(n11); r12 = advance(n12);
+		r20 = advance(n20); r21 = advance(n21); r22 = advance(n22);
+	} else {
+		// a smaller step, only the second half advances
+		r00 = centre(n00); r01 = centre(n01); r02 = centre(n02);
+		r10 = centre(n10); r11 = centre(n11); r12 = centre(n12);
+		r20 = centre(n20); r21 = centre(n21); r22 = centre(n22);
+	}
+
+	return n->result = join(advance(join(r00, r01, r10, r11)), advance(join(r01, r02, r11, r12)),
+	                        advance(join(r10, r11, r20, r21)), advance(join(r11, r12, r21, r22)));
+}
+
+const HashLife::Node* HashLife::set(const Node* n, long long x, long long y, bool alive) {
+	if (n->level == 0)
+		return alive ? live : dead;
+
+	const long long half = 1LL << (n->level - 1);
+	if (x < half) {
+		if (y < half)
+			return join(set(n->nw, x, y, alive), n->ne, n->sw, n->se);
+		return join(n->nw, set(n->ne, x, y - half, alive), n->sw, n->se);
+	}
+	if (y < half)
+		return join(n->nw, n->ne, set(n->sw, x - half, y, alive), n->se);
+	return join(n->nw, n->ne, n->sw, set(n->se, x - half, y - half, alive));
+}
+
+void HashLife::evolve_all() {
+	evolve_pow2(0);
+}
+
+void HashLife::evolve_pow2(int k) {
+	if (storage.size() > (1u << 22))
+		collect();
+
+	if (k != step) {
+		// the memoized results are for another step size
+		for (Node& n : storage)
+			n.result = nullptr;
+		step = k;
+	}
+
+	// grow until the universe is big enough for the step and has an empty margin,
+	// then once more so nothing can escape the center half while it evolves
+	while (root->level < k + 2 || centre(root)->population != root->population)
+		root = expand(root);
+	root = advance(expand(root));
+
+	generation_ += 1LL << k;
+}
+
+void HashLife::evolve(long long n) {
+	for (int k = 0; n != 0; k++, n >>= 1)
+		if (n & 1)
+			evolve_pow2(k);
+}
+
+ConwayCell HashLife::at(long long x, long long y) const {
+	const Node* n = root;
+	long long half = 1LL << (n->level - 1);
+	x += half;
+	y += half;
+
+	if (x < 0 || y < 0 || x >= 2 * half || y >= 2 * half)
+		return ConwayCell('.');
+
+	while (n->level > 0) {
+		half = 1LL << (n->level - 1);
+		if (x < half)
+			n = (y < half) ? n->nw : n->ne;
+		else
+			n = (y < half) ? n->sw : n->se;
+		x %= half;
+		y %= half;
+	}
+
+	return ConwayCell(n->population ? '*' : '.');
+}
+
+long long HashLife::population() const {
+	return root->population;
+}
+
+void HashLife::print(ostream& out) const {
+	string rows;
+	long long window = 0;
+
+	for (int x = 0; x < height; x++) {
+		for (int y = 0; y < width; y++) {
+			const bool alive = at(x, y).is_alive();
+			window += alive;
+			rows += alive ? '*' : '.';
+		}
+		rows += '\n';
+	}
+
+	out << "Generation = " << generation_ << ", Population = " << window << "." << endl;
+	out << rows << endl;
+}
+
+const HashLife::Node* HashLife::copy(const Node* n, unordered_map<const Node*, const Node*>& copies) {
+	if (n->level == 0)
+		return n->population ? live : dead;
+
+	unordered_map<const Node*, const Node*>::const_iterator it = copies.find(n);
+	if (it != copies.end())
+		return it->second;
+
+	const Node* c = join(copy(n->nw, copies), copy(n->ne, copies), copy(n->sw, copies), copy(n->se, copies));
+	copies[n] = c;
+	return c;
+}
+
+void HashLife::collect() {
+	deque<Node> old_storage;
+	old_storage.swap(storage);
+	table.clear();
+	empties.clear();
+
+	const Node leaf = {nullptr, nullptr, nullptr, nullptr, 0, 0, nullptr};
+	storage.push_back(leaf);
+	dead = &storage.back();
+	storage.push_back(leaf);
+	storage.back().population = 1;
+	live = &storage.back();
+
+	unordered_map<const Node*, const Node*> copies;
+	root = copy(root, copies);
+}
@@ -0,0 +1,173 @@
+#ifndef HashLife_h
+#define HashLife_h
+
+#include <deque>
+#include <iostream>
+#include <unordered_map>
+
+#include "Life.h"
+
+// 	------------------------------------------------------------------------
+//	Class HashLife runs Conway's rule with Gosper's HashLife algorithm. The
+//	universe is an unbounded quadtree of canonical (hash consed) nodes, and
+//	every node remembers the future of its center, so repeated or empty
+//	regions cost nothing and 2^k generations can be taken in one step.
+//
+//	Cells outside the h x w window read by the constructor are dead to begin
+//	with but are simulated too, unlike Life<ConwayCell> which holds them dead
+//	forever. The two agree as long as nothing reaches the window's edge.
+// 	------------------------------------------------------------------------
+class HashLife {
+public:
+
+	/**
+	 * constructor
+	 * @param in the istream to read from, the same text Life<ConwayCell> reads
+	 * @param h is the height of the window
+	 * @param w is the width of the window
+	 */
+	HashLife(std::istream& in, int h, int w);
+
+	/**
+	 * print the window, same format as Life<ConwayCell>::print
+	 * the population printed is the one of the window
+	 * @param out the ostream to write to
+	 */
+	void print(std::ostream& out) const;
+
+	/**
+	 * evolve the universe one generation
+	 */
+	void evolve_all();
+
+	/**
+	 * evolve the universe 2^k generations in one step
+	 * the unused nodes are collected first once there are more than 2^22 of them
+	 * @param k the log2 of the number of generations
+	 */
+	void evolve_pow2(int k);
+
+	/**
+	 * evolve the universe n generations, one step per bit of n
+	 * @param n the number of generations
+	 */
+	void evolve(long long n);
+
+	/**
+	 * will retrieve the cell at position (x, y), any position of the universe can be read
+	 * @param x the row of the cell, negative rows are above the window
+	 * @param y the column of the cell, negative columns are left of the window
+	 * @return a copy of the cell at position (x,y)
+	 */
+	ConwayCell at(long long x, long long y) const;
+
+	/**
+	 * how many cells are alive in the whole universe?
+	 * @return the population of the universe
+	 */
+	long long population() const;
+
+	/**
+	 * what generation is the universe at?
+	 * @return the generation
+	 */
+	long long generation() const { return generation_; }
+
+	/**
+	 * how many distinct nodes are stored right now?
+	 * @return the number of nodes
+	 */
+	std::size_t nodes() const { return storage.size(); }
+
+	/**
+	 * drop every node that is no longer part of the universe, along with the memoized futures
+	 */
+	void collect();
+
+private:
+	// 	---------------------------------------------------------------
+	//	Node is a square of 2^level cells, a leaf (level 0) is one cell
+	// 	---------------------------------------------------------------
+	struct Node {
+		const Node* nw;				//top-left quadrant
+		const Node* ne;				//top-right quadrant
+		const Node* sw;				//bottom-left quadrant
+		const Node* se;				//bottom-right quadrant
+		int level;					//log2 of the side of the square
+		long long population;		//live cells in the square
+		mutable const Node* result;	//the center half, 2^min(step, level - 2) generations later
+	};
+
+	// 	-----------------------------------------------------------
+	//	Key and KeyHash index the canonical node of four quadrants
+	// 	-----------------------------------------------------------
+	struct Key {
+		const Node* nw;
+		const Node* ne;
+		const Node* sw;
+		const Node* se;
+
+		bool operator==(const Key& rhs) const {
+			return nw == rhs.nw && ne == rhs.ne && sw == rhs.sw && se == rhs.se;
+		}
+	};
+
+	struct KeyHash {
+		std::size_t operator()(const Key& k) const;
+	};
+
+	/**
+	 * the canonical node made of four quadrants of the same level
+	 */
+	const Node* join(const Node* nw, const Node* ne, const Node* sw, const Node* se);
+
+	/**
+	 * the canonical empty node of a level
+	 */
+	const Node* empty(int level);
+
+	/**
+	 * the same square surrounded by an empty border, one level up and with the same center
+	 */
+	const Node* expand(const Node* n);
+
+	/**
+	 * the center half of a node, one level down
+	 */
+	const Node* centre(const Node* n);
+
+	/**
+	 * the center half of n, 2^min(step, level - 2) generations later, memoized in n
+	 */
+	const Node* advance(const Node* n);
+
+	/**
+	 * the center 2x2 of a 4x4 node one generation later
+	 */
+	const Node* advance_base(const Node* n);
+
+	/**
+	 * n with the cell at row x, column y (relative to the top-left of n) set
+	 */
+	const Node* set(const Node* n, long long x, long long y, bool alive);
+
+	/**
+	 * a copy of n made of the nodes of the current table, used by collect()
+	 */
+	const Node* copy(const Node* n, std::unordered_map<const Node*, const Node*>& copies);
+
+	std::deque<Node> storage;								//every node, never moved
+	std::unordered_map<Key, const Node*, KeyHash> table;	//the canonical node of each key
+	std::deque<const Node*> empties;						//the empty node of each level
+	const Node* dead;										//the dead leaf
+	const Node* live;										//the live leaf
+
+	const Node* root;		//the universe, centered on the top-left corner of the window
+	int step;				//the log2 of the step the memoized results were computed for
+
+	int height;				//height of the window
+	int width;				//width of the window
+	long long generation_;	//generation tracker
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include <vector>
 #include <iostream>
 #include <cassert>
+#include <new>
 
 #include "Life.h"
 
@@ -33,13 +34,17 @@ ConwayCell::ConwayCell(const char& input) {
 		alive = false;
 }
 
-ConwayCell operator+(const ConwayCell& old_cell, const ConwayCell neighbors[8]) {
+ConwayCell operator+(const ConwayCell& old_cell, const Neighborhood<ConwayCell>& neighbors) {
+	// border cells are never alive, so the counts need no border test
 	int live_neighbors = 0;
 
 	for (int i = 0; i < 8; i++)
-		if (!neighbors[i].border && neighbors[i].alive)
-			live_neighbors++;
+		live_neighbors += neighbors[i].alive;
 
+	return old_cell + live_neighbors;
+}
+
+ConwayCell operator+(const ConwayCell& old_cell, int live_neighbors) {
 	if (old_cell.is_alive()) {
 		if (live_neighbors < 2 || live_neighbors > 3)
 			return ConwayCell('.');
@@ -54,35 +59,36 @@ ConwayCell operator+(const ConwayCell& old_cell, const ConwayCell neighbors[8])
 }
 
 
+bool operator==(const ConwayCell& lhs, const ConwayCell& rhs) {
+	return lhs.border == rhs.border && lhs.alive == rhs.alive;
+}
+
 ConwayCell* ConwayCell::clone() const {
 	return new ConwayCell(*this);
 }
 
-Cell ConwayCell::evolve(const Cell neighbors[8]) const {
+AbstractCell* ConwayCell::clone_into(void* buffer, size_t size) const {
+	if (size < sizeof(ConwayCell))
+		return clone();
+	return new (buffer) ConwayCell(*this);
+}
+
+Cell ConwayCell::evolve(const Neighborhood<Cell>& neighbors) const {
+	// border cells are never alive, so the counts need no border test
 	int live_neighbors = 0;
 
-	for (int i = 0; i < 8; i++) 
-		if (!neighbors[i].is_border() && neighbors[i].is_alive())
-			live_neighbors++;
+	for (int i = 0; i < 8; i++)
+		live_neighbors += neighbors[i].is_alive();
 
-	if (alive) {
-		if (live_neighbors < 2 || live_neighbors > 3)
-			return Cell(ConwayCell('.'));
-		else
-			return Cell(ConwayCell('*'));
-	} else { // dead
-		if (live_neighbors == 3)
-			return Cell(ConwayCell('*'));
-		else
-			return Cell(ConwayCell('.'));
-	}
+	return Cell(*this + live_neighbors);
 }
 
 ostream& ConwayCell::print(ostream& out) const {
-	if (alive)
-		return out << '*';
-	else
-		return out << '.';
+	return out << symbol();
+}
+
+char ConwayCell::symbol() const {
+	return alive ? '*' : '.';
 }
 
 // -----------
@@ -102,13 +108,17 @@ FredkinCell::FredkinCell(const char& input) : AbstractCell(false) {
 	}
 }
 
-FredkinCell operator+(const FredkinCell& old_cell, const FredkinCell neighbors[8]) {
+FredkinCell operator+(const FredkinCell& old_cell, const Neighborhood<FredkinCell>& neighbors) {
+	// border cells are never alive, so the counts need no border test
 	int live_neighbors = 0;
 
 	for (int i = 0; i < 4; i++)
-		if (!neighbors[i].border && neighbors[i].alive)
-			live_neighbors++;
+		live_neighbors += neighbors[i].alive;
 
+	return old_cell + live_neighbors;
+}
+
+FredkinCell operator+(const FredkinCell& old_cell, int live_neighbors) {
 	if (old_cell.is_alive()) {
 		if (live_neighbors == 0 || live_neighbors == 2 || live_neighbors == 4)
 			return FredkinCell(old_cell.age(), false);
@@ -123,6 +133,10 @@ FredkinCell operator+(const FredkinCell& old_cell, const FredkinCell neighbors[8
 	}
 }
 
+bool operator==(const FredkinCell& lhs, const FredkinCell& rhs) {
+	return lhs.border == rhs.border && lhs.alive == rhs.alive && lhs.age_ == rhs.age_;
+}
+
 FredkinCell::FredkinCell(int a, bool alive_) : AbstractCell(false) {
 	age_ = a;
 	alive = alive_;
@@ -132,35 +146,34 @@ FredkinCell* FredkinCell::clone() const {
 	return new FredkinCell(*this);
 }
 
-Cell FredkinCell::evolve(const Cell neighbors[8]) const {
+AbstractCell* FredkinCell::clone_into(void* buffer, size_t size) const {
+	if (size < sizeof(FredkinCell))
+		return clone();
+	return new (buffer) FredkinCell(*this);
+}
+
+Cell FredkinCell::evolve(const Neighborhood<Cell>& neighbors) const {
+	// border cells are never alive, so the counts need no border test
 	int live_neighbors = 0;
 
 	for (int i = 0; i < 4; i++)
-		if (!neighbors[i].is_border() && neighbors[i].is_alive())
-			live_neighbors++;
+		live_neighbors += neighbors[i].is_alive();
 
-	if (alive) {
-		if (live_neighbors == 0 || live_neighbors == 2 || live_neighbors == 4)
-			return Cell(FredkinCell(age_, false));
-		else {
-			return Cell(FredkinCell(age_ + 1, true));
-		}
-	} else { // dead
-		if (live_neighbors == 3 || live_neighbors == 1)
-			return Cell(FredkinCell(age_, true));
-		else
-			return Cell(FredkinCell(age_, false));
-	}
+	return Cell(*this + live_neighbors);
 }
 
 ostream& FredkinCell::print(ostream& out) const {
+	return out << symbol();
+}
+
+char FredkinCell::symbol() const {
 	if (!alive)
-		return out << '-';
+		return '-';
 	else {
 		if (age_ < 10) 
-			return out << age_;
+			return '0' + age_;
 		else 
-			return out << '+';
+			return '+';
 	}
 }
 
@@ -175,25 +188,64 @@ const int FredkinCell::age() const {
 
 Cell::Cell(const char& c) {
 	if (c == '.' || c == '*')
-		this->acell = new ConwayCell(c);
+		this->acell = new (&storage) ConwayCell(c);
 	else
-		this->acell = new FredkinCell(c);
+		this->acell = new (&storage) FredkinCell(c);
 }
 
 Cell::Cell(const Cell& c) {
-	this->acell = c.acell->clone();
+	this->acell = c.acell ? c.acell->clone_into(&storage, storage_size) : nullptr;
+}
+
+Cell::Cell(Cell&& c) noexcept {
+	take(c);
 }
 
 Cell::~Cell() {
-	delete acell;
+	release();
 }
 
 Cell& Cell::operator=(const Cell& rhs) {
-	acell = rhs.acell->clone();
+	if (this != &rhs) {
+		release();
+		acell = rhs.acell ? rhs.acell->clone_into(&storage, storage_size) : nullptr;
+	}
+	return *this;
+}
+
+Cell& Cell::operator=(Cell&& rhs) noexcept {
+	if (this != &rhs) {
+		release();
+		take(rhs);
+	}
 	return *this;
 }
 
-Cell operator+(const Cell& old_cell, const Cell neighbors[8]) {
+bool Cell::is_inline() const {
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(acell);
+	const unsigned char* begin = reinterpret_cast<const unsigned char*>(&storage);
+	return p >= begin && p < begin + storage_size;
+}
+
+void Cell::release() {
+	if (is_inline())
+		acell->~AbstractCell();
+	else
+		delete acell;
+	acell = nullptr;
+}
+
+void Cell::take(Cell& c) {
+	if (c.is_inline())
+		// an inline cell fits in storage, clone_into does not allocate
+		acell = c.acell->clone_into(&storage, storage_size);
+	else {
+		acell = c.acell;
+		c.acell = nullptr;
+	}
+}
+
+Cell operator+(const Cell& old_cell, const Neighborhood<Cell>& neighbors) {
 	Cell new_cell = old_cell.acell->evolve(neighbors);
 
 	// If Life is instantiated with Cell, then when a FredkinCell's age is to become 2, and only then, it becomes a live ConwayCell instead.
@@ -205,7 +257,7 @@ Cell operator+(const Cell& old_cell, const Cell neighbors[8]) {
 	return new_cell;
 }
 
-ostream& operator<<(ostream& out, const Cell c) {
+ostream& operator<<(ostream& out, const Cell& c) {
 	return c.acell->print(out);
 }
 
@@ -224,3 +276,74 @@ bool Cell::is_alive() const {
 bool Cell::is_border() const {
 	return acell->is_border();
 }
+
+char Cell::symbol() const {
+	return acell->symbol();
+}
+
+// ---------
+// MixedCell
+// ---------
+
+MixedCell::MixedCell(const char& input) : age_(0) {
+	if (input == '.' || input == '*')
+		state = CONWAY | (input == '*' ? ALIVE : 0);
+	else if (input == '-')
+		state = FREDKIN;
+	else {
+		state = FREDKIN | ALIVE;
+		age_ = (input >= '0' && input <= '9') ? input - '0' : 10;
+	}
+}
+
+MixedCell operator+(const MixedCell& old_cell, const Neighborhood<MixedCell>& neighbors) {
+	// border cells are never alive, so the counts need no border test
+	int orthogonal = 0;
+	for (int i = 0; i < 4; i++)
+		orthogonal += neighbors[i].is_alive();
+
+	int live_neighbors = orthogonal;
+	for (int i = 4; i < 8; i++)
+		live_neighbors += neighbors[i].is_alive();
+
+	const bool alive = old_cell.is_alive();
+
+	switch (old_cell.kind()) {
+	case MixedCell::CONWAY:
+		return MixedCell(MixedCell::CONWAY, live_neighbors == 3 || (alive && live_neighbors == 2), 0);
+
+	case MixedCell::FREDKIN: {
+		// a FredkinCell is alive next generation on 1 or 3 live neighbors, dead or alive now
+		const bool next = (orthogonal & 1) != 0;
+		const bool survives = alive && next;
+
+		// when a FredkinCell's age is to become 2 it becomes a live ConwayCell instead
+		if (survives && old_cell.age_ == 1)
+			return MixedCell(MixedCell::CONWAY, true, 0);
+
+		return MixedCell(MixedCell::FREDKIN, next, old_cell.age_ + (survives && old_cell.age_ < 255));
+	}
+
+	default:
+		return old_cell;
+	}
+}
+
+ostream& operator<<(ostream& out, const MixedCell& c) {
+	return out << c.symbol();
+}
+
+char MixedCell::symbol() const {
+	switch (kind()) {
+	case FREDKIN:
+		if (!is_alive())
+			return '-';
+		if (age() < 10)
+			return '0' + age();
+		return '+';
+
+	default:
+		return is_alive() ? '*' : '.';
+	}
+}
+
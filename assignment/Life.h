@@ -2,12 +2,85 @@
 #define Life_h
 
 #include <vector>
+#include <deque>
+#include <limits>
 #include <iostream>
+#include <new>
+#include <cassert>
+#include <type_traits>
+#include <memory>
+#include <numeric>
+#include <cstddef>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <iterator>
+#include <utility>
 
 #include "gtest/gtest.h"
 
+#include "NeighborCount.h"
+#include "ThreadPool.h"
+
 class Cell;
 
+template <class T>
+struct CellCodec;
+
+// 	-------------------------------------------------------------------------
+//	Class template Neighborhood is a view of the 8 neighbors of a cell, in the
+//	order up, right, down, left, up-right, down-right, down-left, up-left. It
+//	points at the cells where they are, on the board or in an array of 8, so
+//	evolving a cell copies none of them.
+// 	-------------------------------------------------------------------------
+template <class T>
+class Neighborhood {
+public:
+	/**
+	 * the neighbors of the cell at center, where they are on its board
+	 * @param center the cell whose neighbors these are
+	 * @param offsets the offsets of the 8 neighbors from center, see board_offsets
+	 */
+	Neighborhood(const T* center, const std::ptrdiff_t* offsets) : cells(center), offsets_(offsets) {}
+
+	/**
+	 * the neighbors listed in an array, in the order above
+	 * @param neighbors the 8 neighbors
+	 */
+	Neighborhood(const T (&neighbors)[8]) : cells(neighbors), offsets_(listed()) {}
+
+	/**
+	 * the i-th neighbor
+	 * @param i the index of the neighbor, 0 to 7
+	 * @return the neighbor, where it is
+	 */
+	const T& operator[](int i) const {
+		assert(i >= 0 && i < 8);
+		return cells[offsets_[i]];
+	}
+
+	/**
+	 * the offsets of the neighbors of a board of rows of stride cells
+	 * @param stride the distance between the same column of two rows
+	 * @param offsets the offsets, filled in for Neighborhood(center, offsets)
+	 */
+	static void board_offsets(std::ptrdiff_t stride, std::ptrdiff_t offsets[8]) {
+		const std::ptrdiff_t o[8] = {-1, stride, 1, -stride, stride - 1, stride + 1, -stride + 1, -stride - 1};
+		std::copy(o, o + 8, offsets);
+	}
+
+private:
+	static const std::ptrdiff_t* listed() {
+		static const std::ptrdiff_t o[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+		return o;
+	}
+
+	const T* cells;						//the cell, or the first of the array
+	const std::ptrdiff_t* offsets_;		//where each neighbor is from cells
+};
+
 // 	------------------------------------------------------------------
 //	Class AbstractCell is the base class to FredkinCell and ConwayCell
 //	------------------------------------------------------------------
@@ -45,7 +118,7 @@ public:
 	 * @param neighbors the neighbors to the calling cell
 	 * @return the evolved cell
 	 */
-	virtual Cell evolve(const Cell neighbors[8]) const = 0;
+	virtual Cell evolve(const Neighborhood<Cell>& neighbors) const = 0;
 
 	/**
 	 * print this cell's symbol
@@ -54,22 +127,36 @@ public:
 	 */
 	virtual std::ostream& print(std::ostream& out) const = 0;
 
+	/**
+	 * this cell's symbol, the character print writes
+	 * @return the symbol of the cell
+	 */
+	virtual char symbol() const = 0;
+
 	/**
 	 * clone this cell
 	 * @return a pointer to a clone of the cell
 	 */
 	virtual AbstractCell* clone() const = 0;
 
+	/**
+	 * clone this cell into storage owned by the caller, falls back to clone() if it does not fit
+	 * @param buffer where to construct the clone
+	 * @param size the size of buffer in bytes
+	 * @return a pointer to the clone, inside buffer unless the cell is too big for it
+	 */
+	virtual AbstractCell* clone_into(void* buffer, std::size_t size) const { return clone(); }
+
 	/**
 	 * destructor
 	 */
 	virtual ~AbstractCell() {}
 
 	/**
-	 * constructor
+	 * constructor, a border is dead, the cells' counts rely on it
 	 * @param border_ the value if the cell is a border or not
 	 */
-	AbstractCell(bool border_ = false) : border(border_) {}
+	AbstractCell(bool border_ = false) : alive(false), border(border_) {}
 
 	/**
 	 * is the cell alive or dead?
@@ -91,10 +178,26 @@ class ConwayCell : public AbstractCell {
 	/**
 	 * evolve this cell, the operator is to be called on the cell and it's neighbors 
 	 * @param old_cell the cell to evolve
-	 * @param neighbors a vector of neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
+	 * @param neighbors the neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
 	 * @return a new cell that's evolved from old_cell and neighbors
 	 */
-	friend ConwayCell operator+(const ConwayCell& old_cell, const ConwayCell neighbors[8]);
+	friend ConwayCell operator+(const ConwayCell& old_cell, const Neighborhood<ConwayCell>& neighbors);
+
+	/**
+	 * evolve this cell from the number of its live neighbors
+	 * @param old_cell the cell to evolve
+	 * @param live_neighbors how many of the 8 neighbors are alive
+	 * @return a new cell that's evolved from old_cell
+	 */
+	friend ConwayCell operator+(const ConwayCell& old_cell, int live_neighbors);
+
+	/**
+	 * are the two cells in the same state?
+	 * @param lhs the left hand side cell
+	 * @param rhs the right hand side cell
+	 * @return true if both are borders or both are alive or both are dead
+	 */
+	friend bool operator==(const ConwayCell& lhs, const ConwayCell& rhs);
 
 public:
 
@@ -117,18 +220,32 @@ public:
 	 */
 	std::ostream& print(std::ostream& out) const;
 
+	/**
+	 * this cell's symbol, the character print writes
+	 * @return the symbol of the cell
+	 */
+	char symbol() const;
+
 	/**
 	 * evolve the cell
 	 * @param neighbors the neighbors to the calling cell
 	 * @return the evolved cell
 	 */
-	Cell evolve(const Cell neighbors[8]) const;
+	Cell evolve(const Neighborhood<Cell>& neighbors) const;
 
 	/**
 	 * preforms a deep copy on the cell
 	 * @return a pointer to the new cell
 	 */
 	ConwayCell* clone() const;
+
+	/**
+	 * preforms a deep copy on the cell into storage owned by the caller
+	 * @param buffer where to construct the copy
+	 * @param size the size of buffer in bytes
+	 * @return a pointer to the new cell
+	 */
+	AbstractCell* clone_into(void* buffer, std::size_t size) const;
 };
 
 // 	-----------------------------------------------------
@@ -138,10 +255,26 @@ class FredkinCell : public AbstractCell {
 	/**
 	 * evolve this cell, the operator is to be called on the cell and it's neighbors
 	 * @param old_cell the cell to evolve
-	 * @param neighbors a vector of neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
+	 * @param neighbors the neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
 	 * @return a new cell that's evolved from old_cell and neighbors
 	 */
-	friend FredkinCell operator+(const FredkinCell& old_cell, const FredkinCell neighbors[8]);
+	friend FredkinCell operator+(const FredkinCell& old_cell, const Neighborhood<FredkinCell>& neighbors);
+
+	/**
+	 * evolve this cell from the number of its live neighbors
+	 * @param old_cell the cell to evolve
+	 * @param live_neighbors how many of the 4 orthogonal neighbors (up, right, down, left) are alive
+	 * @return a new cell that's evolved from old_cell
+	 */
+	friend FredkinCell operator+(const FredkinCell& old_cell, int live_neighbors);
+
+	/**
+	 * are the two cells in the same state? aging is a change of state
+	 * @param lhs the left hand side cell
+	 * @param rhs the right hand side cell
+	 * @return true if the two cells agree on border, alive and age
+	 */
+	friend bool operator==(const FredkinCell& lhs, const FredkinCell& rhs);
 
 public:
 
@@ -171,12 +304,18 @@ public:
 	 */
 	std::ostream& print(std::ostream& out) const;
 
+	/**
+	 * this cell's symbol, the character print writes
+	 * @return the symbol of the cell
+	 */
+	char symbol() const;
+
 	/**
 	 * evolve the cell
 	 * @param neighbors the neighbors to the calling cell
 	 * @return the evolved cell
 	 */
-	Cell evolve(const Cell neighbors[8]) const;
+	Cell evolve(const Neighborhood<Cell>& neighbors) const;
 
 	/**
 	 * preforms a deep copy on the cell
@@ -184,6 +323,14 @@ public:
 	 */
 	FredkinCell* clone() const;
 
+	/**
+	 * preforms a deep copy on the cell into storage owned by the caller
+	 * @param buffer where to construct the copy
+	 * @param size the size of buffer in bytes
+	 * @return a pointer to the new cell
+	 */
+	AbstractCell* clone_into(void* buffer, std::size_t size) const;
+
 	/**
 	 * what is the age of the fredkincell?
 	 * @return the age of the fredkincell
@@ -196,22 +343,24 @@ protected:
 
 // 	-----------------------------------------------------------------------
 //	Class Cell is the handler class for handle fredkincells and conwaycells
+//	ConwayCells and FredkinCells are stored inside the Cell itself, acell
+//	only points to the heap for cells assigned to it by the caller
 //	-----------------------------------------------------------------------
 class Cell {
 	/**
 	 * evolve this cell, the operator is to be called on the cell and it's neighbors, works for all cells
 	 * @param old_cell the cell to evolve
-	 * @param neighbors a vector of neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
+	 * @param neighbors the neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
 	 * @return a new cell that's evolved from old_cell and neighbors
 	 */
-	friend Cell operator+(const Cell& old_cell, const Cell neigbors[8]);
+	friend Cell operator+(const Cell& old_cell, const Neighborhood<Cell>& neighbors);
 
 	/**
 	 * print this cell's symbol, works for all cells
 	 * @param out the ostream to write to
 	 * @return the ostream
 	 */
-	friend std::ostream& operator<<(std::ostream& out, const Cell c);
+	friend std::ostream& operator<<(std::ostream& out, const Cell& c);
 
 	/**
 	 * read a symbol to a cell, works for all cells
@@ -221,26 +370,30 @@ class Cell {
 	 */
 	friend std::istream& operator>>(std::istream& in, Cell& c);
 
+	static const std::size_t storage_size = sizeof(FredkinCell) > sizeof(ConwayCell) ? sizeof(FredkinCell) : sizeof(ConwayCell);
+
+	std::aligned_storage<storage_size>::type storage;	//inline home of the encapsulated cell
+
 public:
 	AbstractCell *acell;		//pointer to the cell object encapsulated by the Cell class
 
 	/**
-	 * constructor
+	 * constructor, takes ownership of a cell allocated with new
 	 * @param c the cell to be encapsulated, assigned to variable acell
 	 */
 	Cell(AbstractCell* c = nullptr) : acell(c) {}
 
 	/**
 	 * constructor
-	 * @param c the cell to be encapsulated, assigned to variable acell
+	 * @param c the cell to be encapsulated, a copy is assigned to variable acell
 	 */
-	Cell(const AbstractCell& c) : acell(c.clone()) {}
+	Cell(const AbstractCell& c) : acell(c.clone_into(&storage, storage_size)) {}
 
 	/**
 	 * constructor
 	 * @param border_ the value if the cell is a border or not
 	 */
-	Cell(bool border_) : acell(new ConwayCell(border_)) {}
+	Cell(bool border_) : acell(new (&storage) ConwayCell(border_)) {}
 
 	/**
 	 * constructor
@@ -254,30 +407,419 @@ public:
 	 */
 	Cell(const Cell& c);
 
+	/**
+	 * move constructor, takes the cell of c if it is on the heap, copies it if it is inline
+	 * neither allocates, a c that owned a heap cell is left without a cell
+	 * @param c is the cell to be moved to this cell
+	 */
+	Cell(Cell&& c) noexcept;
+
 	/**
 	 * destructor
 	 */
 	~Cell();
 
 	/**
-	 * will call clone on this cell with the parameter rhs
+	 * will release the encapsulated cell and clone the one of rhs
 	 * @param rhs the right hand side side to be copied from
 	 * @return a pointer this
 	 */
 	Cell& operator=(const Cell& rhs);
 
+	/**
+	 * will release the encapsulated cell and take the one of rhs, like the move constructor
+	 * @param rhs the right hand side side to be moved from
+	 * @return a pointer this
+	 */
+	Cell& operator=(Cell&& rhs) noexcept;
+
 	/**
 	 * is the cell alive or dead?
 	 * @return true if alive, false if dead
 	 */
 	bool is_alive() const;
 	bool is_border() const;
+
+	/**
+	 * the encapsulated cell's symbol, the character operator<< writes
+	 * @return the symbol of the cell
+	 */
+	char symbol() const;
+
+private:
+	/**
+	 * is acell stored inside this Cell rather than on the heap?
+	 * @return true if acell points into storage
+	 */
+	bool is_inline() const;
+
+	/**
+	 * destroy the encapsulated cell, deleting it if it lives on the heap
+	 */
+	void release();
+
+	/**
+	 * take the cell of c, acell must not hold a cell
+	 * @param c the cell to move from
+	 */
+	void take(Cell& c);
+};
+
+// 	--------------------------------------------------------------------------
+//	Class MixedCell follows the same rules as Cell, but is a plain value that
+//	holds its kind, alive and age in two bytes, so Life<MixedCell> evolves a
+//	mixed board without virtual calls, casts or heap allocations
+// 	--------------------------------------------------------------------------
+class MixedCell {
+	/**
+	 * evolve this cell, the operator is to be called on the cell and it's neighbors, works for all kinds
+	 * @param old_cell the cell to evolve
+	 * @param neighbors the neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
+	 * @return a new cell that's evolved from old_cell and neighbors
+	 */
+	friend MixedCell operator+(const MixedCell& old_cell, const Neighborhood<MixedCell>& neighbors);
+
+	/**
+	 * print a cell's symbol, the same symbol Cell prints
+	 * @param out the ostream to write to
+	 * @param c the cell we want to print
+	 * @return the ostream
+	 */
+	friend std::ostream& operator<<(std::ostream& out, const MixedCell& c);
+
+	friend struct CellCodec<MixedCell>;
+
+public:
+	enum Kind { BORDER, CONWAY, FREDKIN };
+
+	/**
+	 * constructor
+	 * @param border_ true for a border cell, false for a dead ConwayCell
+	 */
+	MixedCell(bool border_ = false) : state(border_ ? BORDER : CONWAY), age_(0) {}
+
+	/**
+	 * constructor
+	 * @param input the character representation of a cell, Conway or Fredkin
+	 */
+	MixedCell(const char& input);
+
+	/**
+	 * is the cell alive or dead?
+	 * @return true if alive, false if dead
+	 */
+	bool is_alive() const { return (state & ALIVE) != 0; }
+
+	/**
+	 * is the cell a border?
+	 * @return true if border, false if not a border
+	 */
+	bool is_border() const { return kind() == BORDER; }
+
+	/**
+	 * is this a border, Conway or Fredkin cell?
+	 * @return the kind of the cell
+	 */
+	Kind kind() const { return Kind(state & KIND); }
+
+	/**
+	 * what is the age of the cell? only Fredkin cells age, it stops counting at 255
+	 * @return the age of the cell
+	 */
+	int age() const { return age_; }
+
+	/**
+	 * this cell's symbol, the character operator<< writes
+	 * @return the symbol of the cell
+	 */
+	char symbol() const;
+
+private:
+	/**
+	 * constructor
+	 * @param k the kind of the cell
+	 * @param alive_ the boolean to determine is the cell is alive or not
+	 * @param a the age of the cell
+	 */
+	MixedCell(Kind k, bool alive_, unsigned char a) : state(k | (alive_ ? ALIVE : 0)), age_(a) {}
+
+	enum { KIND = 3, ALIVE = 4 };
+
+	unsigned char state;	//the kind in bits 0 and 1, alive in bit 2, border cells are never alive
+	unsigned char age_;		//the age of a Fredkin cell
+};
+
+// 	-------------------------------------------------------------------------
+//	NeighborKernel<T> tells Life<T> whether T evolves from a live neighbor
+//	count alone, in which case the counts are computed a row at a time by the
+//	vectorized kernels in NeighborCount.h
+// 	-------------------------------------------------------------------------
+template <class T>
+struct NeighborKernel {
+	static const bool dense = false;
+};
+
+template <>
+struct NeighborKernel<ConwayCell> {
+	static const bool dense = true;
+
+	static void count(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+		moore_counts(up, mid, down, out, n);
+	}
+};
+
+template <>
+struct NeighborKernel<FredkinCell> {
+	static const bool dense = true;
+
+	static void count(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+		von_neumann_counts(up, mid, down, out, n);
+	}
+};
+
+// 	-------------------------------------------------------------------------
+//	CellCodec<T> packs a cell into the bits a Life<T> checkpoint stores for
+//	it, 1 bit for a ConwayCell, the alive bit and the age for the others
+// 	-------------------------------------------------------------------------
+template <>
+struct CellCodec<ConwayCell> {
+	static const unsigned char kind = 1;	//tells the cell types of checkpoints apart
+	static const int bits = 1;				//the size of one packed cell
+	static const std::uint32_t variant = 0;	//tells the cells of one kind apart, such as the rules of RuleCells
+
+	static std::uint32_t encode(const ConwayCell& c) { return c.is_alive(); }
+	static ConwayCell decode(std::uint32_t v) { return ConwayCell(v ? '*' : '.'); }
+};
+
+template <>
+struct CellCodec<FredkinCell> {
+	static const unsigned char kind = 2;
+	static const int bits = 32;
+	static const std::uint32_t variant = 0;
+
+	// alive in bit 0, the age above it
+	static std::uint32_t encode(const FredkinCell& c) { return (std::uint32_t) c.age() << 1 | c.is_alive(); }
+	static FredkinCell decode(std::uint32_t v) { return FredkinCell(v >> 1, v & 1); }
+};
+
+template <>
+struct CellCodec<Cell> {
+	static const unsigned char kind = 3;
+	static const int bits = 32;
+	static const std::uint32_t variant = 0;
+
+	// alive in bit 0, set bit 1 for a FredkinCell, the age above them
+	static std::uint32_t encode(const Cell& c) {
+		const FredkinCell* f = dynamic_cast<const FredkinCell*>(c.acell);
+		return f ? (std::uint32_t) f->age() << 2 | 2 | f->is_alive() : (std::uint32_t) c.is_alive();
+	}
+	static Cell decode(std::uint32_t v) {
+		if (v & 2)
+			return Cell(FredkinCell(v >> 2, v & 1));
+		return Cell(ConwayCell((v & 1) ? '*' : '.'));
+	}
+};
+
+template <>
+struct CellCodec<MixedCell> {
+	static const unsigned char kind = 4;
+	static const int bits = 16;
+	static const std::uint32_t variant = 0;
+
+	// the state byte, then the age byte
+	static std::uint32_t encode(const MixedCell& c) { return c.state | c.age_ << 8; }
+	static MixedCell decode(std::uint32_t v) {
+		return MixedCell(MixedCell::Kind(v & MixedCell::KIND), (v & MixedCell::ALIVE) != 0, v >> 8);
+	}
+};
+
+// 	-------------------------------------------------------------------------
+//	NoStats and LifeStats are the statistics policies of Life<T, Stats>. The
+//	kernel of evolve_all hands every evolved cell to count(), so the numbers
+//	come out of the same pass that evolves the board. NoStats does nothing
+//	and compiles away.
+// 	-------------------------------------------------------------------------
+struct NoStats {
+	void clear() {}
+
+	template <class T>
+	void count(int, int, bool, const T&) {}
+
+	void merge(const NoStats&) {}
+};
+
+struct LifeStats {
+	static const int age_buckets = 11;	//ages 0 to 9, then every age from 10 on, like the symbols
+
+	int births;					//cells that came alive in the last generation
+	int deaths;					//cells that died in the last generation
+	int top;					//the first row with a live cell, INT_MAX if there is none
+	int left;					//the first column with a live cell
+	int bottom;					//the last row with a live cell, -1 if there is none
+	int right;					//the last column with a live cell
+	int ages[age_buckets];		//how many live FredkinCells have each age
+
+	LifeStats() { clear(); }
+
+	/**
+	 * forget the last generation
+	 */
+	void clear() {
+		births = 0;
+		deaths = 0;
+		top = left = std::numeric_limits<int>::max();
+		bottom = right = -1;
+		std::fill(ages, ages + age_buckets, 0);
+	}
+
+	/**
+	 * record one evolved cell
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @param was_alive was the cell alive before it evolved?
+	 * @param cell the evolved cell
+	 */
+	template <class T>
+	void count(int x, int y, bool was_alive, const T& cell) {
+		const bool alive = cell.is_alive();
+		births += alive && !was_alive;
+		deaths += was_alive && !alive;
+
+		if (alive) {
+			top = std::min(top, x);
+			bottom = std::max(bottom, x);
+			left = std::min(left, y);
+			right = std::max(right, y);
+
+			const int a = age_of(cell);
+			if (a >= 0)
+				ages[std::min(a, age_buckets - 1)]++;
+		}
+	}
+
+	/**
+	 * add the cells recorded by another worker
+	 * @param rhs the statistics of the other cells
+	 */
+	void merge(const LifeStats& rhs) {
+		births += rhs.births;
+		deaths += rhs.deaths;
+		top = std::min(top, rhs.top);
+		bottom = std::max(bottom, rhs.bottom);
+		left = std::min(left, rhs.left);
+		right = std::max(right, rhs.right);
+		for (int i = 0; i < age_buckets; i++)
+			ages[i] += rhs.ages[i];
+	}
+
+	/**
+	 * is there any live cell in the bounding box?
+	 * @return true if no cell is alive
+	 */
+	bool empty() const { return bottom < 0; }
+
+private:
+	/**
+	 * the age of a FredkinCell, -1 for the cells that do not age
+	 */
+	template <class T>
+	static int age_of(const T&) { return -1; }
+	static int age_of(const FredkinCell& c) { return c.age(); }
+	static int age_of(const MixedCell& c) { return c.kind() == MixedCell::FREDKIN ? c.age() : -1; }
+	static int age_of(const Cell& c) {
+		const FredkinCell* f = dynamic_cast<const FredkinCell*>(c.acell);
+		return f ? f->age() : -1;
+	}
+};
+
+// 	-------------------------------------------------------------------------
+//	NoProbe is the default instrumentation policy of Life<T, Stats, Boundary,
+//	Probe>, its hooks do nothing and compile away. LifeProbe in LifeProbe.h
+//	times the construction, every evolve_all and every print.
+// 	-------------------------------------------------------------------------
+struct NoProbe {
+	void loading() {}
+
+	template <class L>
+	void loaded(const L&) {}
+
+	void evolving() {}
+
+	template <class L>
+	void evolved(const L&) {}
+
+	void printing() {}
+
+	template <class L>
+	void printed(const L&, std::size_t) {}
+};
+
+// 	-------------------------------------------------------------------------
+//	Snapshot is one generation of a board, copied out by Life::snapshot so it
+//	can be printed by another thread while the board keeps evolving. Taking
+//	one into a snapshot that was used before allocates nothing.
+// 	-------------------------------------------------------------------------
+template <class T>
+struct Snapshot {
+	int generation;			//the generation of the board
+	int population;			//the population of the board
+	int height;				//height of the board
+	int width;				//width of the board
+	std::vector<T> cells;	//the cells, row by row, without the border
+
+	/**
+	 * print the generation, same format as Life::print
+	 * @param out the ostream to write to
+	 */
+	void print(std::ostream& out) const {
+		std::string text = "Generation = " + std::to_string(generation) + ", Population = " + std::to_string(population) + ".\n";
+		const std::size_t header = text.size();
+
+		text.resize(header + (std::size_t) height * (width + 1) + 1, '\n');
+		char* p = &text[header];
+		for (int x = 0; x < height; x++, p++)
+			for (int y = 0; y < width; y++)
+				*p++ = cells[x * width + y].symbol();
+
+		out.write(text.data(), text.size());
+	}
 };
 
+// 	-------------------------------------------------------------------------
+//	DeadBoundary, TorusBoundary and GrowBoundary are the boundary policies of
+//	Life<T, Stats, Boundary>. The board is surrounded by a ring of dead border
+//	cells that are read but never evolved, so the interior needs no edge test;
+//	only the ring and the outer rows and columns are handled by the policy.
+//	DeadBoundary holds the cells outside the board dead forever. TorusBoundary
+//	refreshes the ring with the opposite edges before every generation, so the
+//	board wraps around. GrowBoundary makes the board bigger on the sides that
+//	have a live cell on their edge, before the cell could get out.
+// 	-------------------------------------------------------------------------
+struct DeadBoundary {};
+struct TorusBoundary {};
+struct GrowBoundary {};
+
+/**
+ * the cell GrowBoundary fills the new rows and columns with
+ * @return a dead cell of the kind a board of T is read with
+ */
+template <class T>
+T dead_cell() {
+	return T('.');
+}
+
+template <>
+inline FredkinCell dead_cell<FredkinCell>() {
+	return FredkinCell('-');
+}
+
 // 	----------------------------------------------------
 //	Generic Class Life has the board to the game of life
+//	Stats is the statistics policy, NoStats or LifeStats
+//	Boundary is the boundary policy, DeadBoundary by default
+//	Probe is the instrumentation policy, NoProbe or LifeProbe
 //	----------------------------------------------------
-template <class T>
+template <class T, class Stats = NoStats, class Boundary = DeadBoundary, class Probe = NoProbe>
 class Life {
 public:
 
@@ -288,104 +830,483 @@ public:
 	 * @param w is the width of the board (without borders as they are hidden from the user)
 	 */	
 	Life(std::istream& in, int h, int w) {
-		width = w;
-		height = h;
-		generation = 0;
-		population = 0;
+		probe_.loading();
 
-		int x = 0;
-		int y = 0;
+		// the whole board in one read, h rows of w glyphs and a newline
+		std::vector<char> buffer((std::size_t) h * (w + 1));
+		in.read(buffer.data(), buffer.size());
+		const std::size_t size = in.gcount();
 
-		board.resize((width + 2) * (height + 2), T(true)); // initialize board, fill it with borders
+		// the blank line that ends the board
+		if (size == buffer.size() && in.peek() == '\n')
+			in.get();
 
-		while (true) {
-			int input = in.get();
+		load(buffer.data(), size, h, w);
+		probe_.loaded(*this);
+	}
 
-			if (input == EOF || (input == '\n' && y == 0))
-				break;
+	/**
+	 * constructor, for callers that already hold the bytes of the board
+	 * @param data the text of the board, in the format the istream constructor reads
+	 * @param size the number of bytes in data
+	 * @param h is the height of the board (without borders as they are hidden from the user)
+	 * @param w is the width of the board (without borders as they are hidden from the user)
+	 */
+	Life(const char* data, std::size_t size, int h, int w) {
+		probe_.loading();
+		load(data, size, h, w);
+		probe_.loaded(*this);
+	}
 
-			if (input == '\n') {
-				x++;
-				assert(y == width);
-				y = 0;
-				continue;
-			}
+	/**
+	 * constructor, restores a checkpoint written by save()
+	 * @param in the istream to read from, the header is read first, then all the cells in one read
+	 * @throws std::runtime_error if in does not hold a checkpoint of a Life<T>
+	 */
+	explicit Life(std::istream& in) {
+		probe_.loading();
+
+		std::vector<char> buffer(checkpoint_header);
+		in.read(buffer.data(), buffer.size());
+		if ((std::size_t) in.gcount() != buffer.size())
+			throw std::runtime_error("not a Life checkpoint");
+		check_header(buffer.data());
+
+		const int h = get(&buffer[8], 4);
+		const int w = get(&buffer[12], 4);
+		buffer.resize(checkpoint_size(h, w));
+		in.read(&buffer[checkpoint_header], buffer.size() - checkpoint_header);
+
+		restore(buffer.data(), checkpoint_header + in.gcount());
+		probe_.loaded(*this);
+	}
 
-			// Add the actual cell
-			T new_cell = T((char) input);
+	/**
+	 * constructor, restores a checkpoint held in memory, such as a mapped file
+	 * @param data the checkpoint written by save()
+	 * @param size the number of bytes in data
+	 * @throws std::runtime_error if data does not hold a checkpoint of a Life<T>
+	 */
+	Life(const char* data, std::size_t size) {
+		probe_.loading();
+		restore(data, size);
+		probe_.loaded(*this);
+	}
 
-			if (new_cell.is_alive())
-				population++;
+	/**
+	 * write a checkpoint of the board, restored by Life(std::istream&)
+	 * @param out the ostream to write to
+	 */
+	void save(std::ostream& out) const {
+		std::vector<char> buffer(checkpoint_size(height, width));
+		save(buffer.data());
+		out.write(buffer.data(), buffer.size());
+	}
 
-			at(x, y).~T();	// deallocate
-			at(x, y) = new_cell;
+	/**
+	 * write a checkpoint of the board into a region of memory, such as a mapped file
+	 * the header is "LIFE", the version (2 bytes), CellCodec<T>::kind and bits (1 byte each),
+	 * the height and width (4 bytes each), the generation and population (8 bytes each),
+	 * CellCodec<T>::variant (4 bytes) and 4 bytes of zeros, then the cells row by row, all little endian
+	 * @param out where the checkpoint_size(height, width) bytes are written
+	 * @return one past the last byte written
+	 */
+	char* save(char* out) const {
+		std::memcpy(out, "LIFE", 4);
+		put(out + 4, checkpoint_version, 2);
+		put(out + 6, CellCodec<T>::kind, 1);
+		put(out + 7, CellCodec<T>::bits, 1);
+		put(out + 8, height, 4);
+		put(out + 12, width, 4);
+		put(out + 16, generation_, 8);
+		put(out + 24, population_, 8);
+		put(out + 32, CellCodec<T>::variant, 4);
+		put(out + 36, 0, 4);
+
+		char* p = out + checkpoint_header;
+		const int bytes = CellCodec<T>::bits / 8;
+		for (int x = 0; x < height; x++)
+			for (int y = 0; y < width; y++) {
+				const std::uint32_t v = CellCodec<T>::encode(board[(x + 1) * (width + 2) + y + 1]);
+				if (bytes == 0) {
+					// 8 cells to a byte, the first in bit 0
+					const long long i = (long long) x * width + y;
+					if (i % 8 == 0)
+						p[i / 8] = 0;
+					p[i / 8] |= v << (i % 8);
+				} else {
+					put(p, v, bytes);
+					p += bytes;
+				}
+			}
 
-			y++;
-		}
+		return out + checkpoint_size(height, width);
+	}
 
-		assert(x == height);
+	/**
+	 * how big is the checkpoint of a board?
+	 * @param h the height of the board
+	 * @param w the width of the board
+	 * @return the size of the checkpoint in bytes
+	 */
+	static std::size_t checkpoint_size(int h, int w) {
+		const std::size_t cells = (std::size_t) h * w;
+		return checkpoint_header + (CellCodec<T>::bits == 1 ? (cells + 7) / 8 : cells * (CellCodec<T>::bits / 8));
 	}
 
 	/**
 	 * print this cell's symbol, works for all cells
+	 * the whole generation is rendered into one buffer and written at once, without a flush
 	 * @param out the ostream to write to
 	 */
-	void print(std::ostream& out) {
-		out << "Generation = " << generation << ", Population = " << population << "." << std::endl;
-		for (int x = 1; x < height + 1; x++) {
-			for (int y = 1; y < width + 1; y++) {
-				const T cell = board[x * (width + 2) + y];
+	void print(std::ostream& out) const {
+		probe_.printing();
 
-				out << cell;
-			}
+		std::string text = "Generation = " + std::to_string(generation_) + ", Population = " + std::to_string(population_) + ".\n";
+		const std::size_t header = text.size();
 
-			out << std::endl;
-		}
-		out << std::endl;
+		text.resize(header + (std::size_t) height * (width + 1) + 1);
+		*print(&text[header]) = '\n';
+
+		out.write(text.data(), text.size());
+		probe_.printed(*this, text.size());
 	}
 
 	/**
-	 * will call the function evolve on the whole cell
+	 * print the board in the run length encoded format of pattern files, for Conway boards only
+	 * a header line "x = width, y = height, rule = B3/S23", then runs of dead (b) and
+	 * live (o) cells, $ between rows and ! at the end, lines at most 70 characters long
+	 * @param out the ostream to write to
 	 */
-	void evolve_all() {
-		population = 0;
-
-		std::vector<T> temp_board = board;
+	void print_rle(std::ostream& out) const {
+		static_assert(std::is_same<T, ConwayCell>::value, "only Conway boards have an RLE format");
+
+		std::string text = "x = " + std::to_string(width) + ", y = " + std::to_string(height) + ", rule = B3/S23\n";
+		std::string line;
+
+		// append "<count><tag>", starting a new line when the current one would pass 70 characters
+		auto emit = [&text, &line](int count, char tag) {
+			const std::string token = (count > 1 ? std::to_string(count) : std::string()) + tag;
+			if (line.size() + token.size() > 70) {
+				text += line + '\n';
+				line.clear();
+			}
+			line += token;
+		};
 
+		int row_ends = 0;	// the $ owed before the next live cell, trailing empty rows need none
 		for (int x = 0; x < height; x++) {
-			for (int y = 0; y < width; y++) {
-				const T& cell = at(x, y);
-
-				T neighbors[8] = {
-					temp_board[(x + 1) * (width + 2) + y],		// up
-					temp_board[(x + 2) * (width + 2) + y + 1],	// right
-					temp_board[(x + 1) * (width + 2) + y + 2],	// down
-					temp_board[(x) * (width + 2) + y + 1],		// left
-					temp_board[(x + 2) * (width + 2) + y],		// top-right
-					temp_board[(x + 2) * (width + 2) + y + 2],	// bottom-right
-					temp_board[(x) * (width + 2) + y + 2],		// bottom-left
-					temp_board[(x) * (width + 2) + y]};			// top-left
-
-				T new_cell = cell + neighbors;
-				
-				if (new_cell.is_alive())
-					population++;
-				
-				at(x, y).~T();		// deallocate old cell to avoid memory leaks
-				at(x, y) = new_cell;
+			if (x > 0)
+				row_ends++;
+
+			const T* row = &board[(x + 1) * (width + 2) + 1];
+			int y = 0;
+			while (y < width) {
+				const bool alive = row[y].is_alive();
+				int run = 1;
+				while (y + run < width && row[y + run].is_alive() == alive)
+					run++;
+
+				// a row's trailing dead cells are left out
+				if (alive || y + run < width) {
+					if (row_ends) {
+						emit(row_ends, '$');
+						row_ends = 0;
+					}
+					emit(run, alive ? 'o' : 'b');
+				}
+				y += run;
 			}
 		}
+		emit(1, '!');
 
-		generation++;
+		text += line + '\n';
+		out.write(text.data(), text.size());
 	}
 
 	/**
-	 * will retrieve the cell at position (x, y) in the board
-	 * @param x the horizontal variable (without borders as they are hidden from the user)
+	 * write the grid into a region of memory, such as a mapped file, without any stream
+	 * row x starts at out + x * (width + 1), each row is width symbols and a newline
+	 * @param out where the height * (width + 1) bytes are written
+	 * @return one past the last byte written
+	 */
+	char* print(char* out) const {
+		for (int x = 1; x < height + 1; x++) {
+			const T* row = &board[x * (width + 2) + 1];
+			for (int y = 0; y < width; y++)
+				*out++ = row[y].symbol();
+			*out++ = '\n';
+		}
+		return out;
+	}
+
+	/**
+	 * will call the function evolve on the whole cell
+	 * generation N + 1 is written into the back buffer, then the two boards are swapped
+	 */
+	void evolve_all() {
+		typedef std::integral_constant<bool, NeighborKernel<T>::dense> dense;
+
+		probe_.evolving();
+		grow(Boundary());
+		prepare(dense());
+		wrap(Boundary(), dense());
+
+		stats_.clear();
+
+		if (tile_size)
+			population_ = evolve_active(dense());
+		else if (!pool)
+			population_ = evolve_rows(dense(), 0, height, band_counts[0], stats_);
+		else {
+			// one band of rows per worker, each worker counts the population of its own band
+			const int bands = pool->size();
+			pool->run([this, bands](int b) {
+				band_stats[b].clear();
+				band_population[b] = evolve_rows(dense(), b * height / bands, (b + 1) * height / bands, band_counts[b], band_stats[b]);
+			});
+			population_ = std::accumulate(band_population.begin(), band_population.end(), 0);
+			for (int b = 0; b < bands; b++)
+				stats_.merge(band_stats[b]);
+		}
+
+		finish(dense());
+
+		board.swap(next_board);
+		generation_++;
+		probe_.evolved(*this);
+	}
+
+	/**
+	 * only evolve the tiles that changed last generation and the tiles around them
+	 * every other tile is left as it is, the back buffer already holds the same cells
+	 * tracking is only done for the cells NeighborKernel<T> counts (ConwayCell and FredkinCell)
+	 * @param tile the side of the square tiles, 0 evolves the whole board every generation
+	 * @return true if evolve_all now tracks the changed tiles
+	 */
+	bool set_tracking(int tile) {
+		if (!NeighborKernel<T>::dense || tile < 1) {
+			tile_size = 0;
+			return false;
+		}
+
+		tile_size = tile;
+		tile_rows = (height + tile - 1) / tile;
+		tile_cols = (width + tile - 1) / tile;
+		alive_stale = true;	// evaluates every tile once
+		dirty.assign(tile_rows * tile_cols, 1);
+		next_dirty.assign(tile_rows * tile_cols, 0);
+		tile_population.assign(tile_rows * tile_cols, 0);
+		tile_stats.assign(tile_rows * tile_cols, Stats());
+		return true;
+	}
+
+	/**
+	 * the side of the tiles evolve_all tracks
+	 * @return the tile side, 0 when every cell is evolved
+	 */
+	int tracking() const {
+		return tile_size;
+	}
+
+	/**
+	 * how many tiles the last generation evolved, every other one was skipped
+	 * @return the number of tiles evolved, 0 when not tracking
+	 */
+	int active_tiles() const {
+		return tile_size ? (int) active.size() : 0;
+	}
+
+	/**
+	 * how many cells did the last generation evolve? tracking skips the others
+	 * @return the number of cells evolved
+	 */
+	long long evolved_cells() const {
+		if (!tile_size)
+			return (long long) height * width;
+
+		long long cells = 0;
+		for (int t : active)
+			cells += (long long) std::min(tile_size, height - t / tile_cols * tile_size) * std::min(tile_size, width - t % tile_cols * tile_size);
+		return cells;
+	}
+
+	/**
+	 * evolve the board k generations, jumping ahead once it repeats itself
+	 * a hash of the board is kept for the last max_period generations; when a hash comes back the
+	 * board is compared cell by cell with itself one period later, and if it matches the remaining
+	 * whole periods are skipped, so generation and population stay exact
+	 * @param k the number of generations
+	 * @param max_period the longest cycle looked for
+	 * @return the period the board settled into, 1 for a still life, 0 if it was not found to repeat
+	 */
+	int evolve_n(int k, int max_period = 64) {
+		std::deque<std::uint64_t> history(1, state_hash());	// the hashes of the last generations, newest last
+		std::vector<std::uint32_t> snapshot;
+
+		while (k > 0) {
+			evolve_all();
+			k--;
+
+			const std::uint64_t hash = state_hash();
+			int period = 0;
+			for (int p = 1; p <= (int) history.size() && p <= k; p++)
+				if (history[history.size() - p] == hash) {
+					period = p;
+					break;
+				}
+
+			if (period == 0) {
+				history.push_back(hash);
+				if ((int) history.size() > max_period)
+					history.pop_front();
+				continue;
+			}
+
+			// the hashes could collide, the board has to come back to this exact state
+			encode_cells(snapshot);
+			for (int i = 0; i < period; i++)
+				evolve_all();
+			k -= period;
+
+			std::vector<std::uint32_t> cells;
+			encode_cells(cells);
+			if (cells == snapshot) {
+				generation_ += k - k % period;
+				for (k %= period; k > 0; k--)
+					evolve_all();
+				return period;
+			}
+
+			history.assign(1, state_hash());
+		}
+
+		return 0;
+	}
+
+	/**
+	 * split evolve_all over n workers, each one evolving a horizontal band of rows
+	 * the threads are started here and kept for every later generation
+	 * @param n the number of workers, 1 evolves on the calling thread only
+	 */
+	void set_threads(int n) {
+		if (n < 1)
+			n = 1;
+
+		if (n == 1)
+			pool.reset();
+		else if (!pool || pool->size() != n)
+			pool.reset(new ThreadPool(n));
+
+		band_population.assign(n, 0);
+		band_stats.assign(n, Stats());
+		band_counts.assign(n, std::vector<unsigned char>(width));
+	}
+
+	/**
+	 * how many workers evolve_all is split over
+	 * @return the number of workers
+	 */
+	int threads() const {
+		return pool ? pool->size() : 1;
+	}
+
+	/**
+	 * the instrumentation of the board, to set up a LifeProbe
+	 * @return the probe
+	 */
+	Probe& probe() {
+		return probe_;
+	}
+
+	/**
+	 * the instrumentation of the board, to read what a LifeProbe measured
+	 * @return the probe
+	 */
+	const Probe& probe() const {
+		return probe_;
+	}
+
+	/**
+	 * the statistics of the last generation evolved, gathered by the Stats policy
+	 * @return the statistics
+	 */
+	const Stats& stats() const {
+		return stats_;
+	}
+
+	/**
+	 * copy the current generation into a snapshot, the only work done on this thread for printing it
+	 * @param s the snapshot, its cells are reused
+	 */
+	void snapshot(Snapshot<T>& s) const {
+		s.generation = generation_;
+		s.population = population_;
+		s.height = height;
+		s.width = width;
+		s.cells.resize(height * width, board[0]);
+		for (int x = 0; x < height; x++) {
+			const T* row = &board[(x + 1) * (width + 2) + 1];
+			std::copy(row, row + width, s.cells.begin() + x * width);
+		}
+	}
+
+	/**
+	 * what generation is the board at?
+	 * @return the generation
+	 */
+	int generation() const {
+		return generation_;
+	}
+
+	/**
+	 * how many cells are alive?
+	 * @return the population
+	 */
+	int population() const {
+		return population_;
+	}
+
+	/**
+	 * where the first row that was read is now, GrowBoundary adds rows above it
+	 * @return the row of the board, 0 unless the board grew up
+	 */
+	int origin_row() const {
+		return origin_row_;
+	}
+
+	/**
+	 * where the first column that was read is now, GrowBoundary adds columns left of it
+	 * @return the column of the board, 0 unless the board grew left
+	 */
+	int origin_col() const {
+		return origin_col_;
+	}
+
+	/**
+	 * how tall is the board? it only changes when GrowBoundary grows it
+	 * @return the number of rows
+	 */
+	int rows() const {
+		return height;
+	}
+
+	/**
+	 * how wide is the board? it only changes when GrowBoundary grows it
+	 * @return the number of columns
+	 */
+	int cols() const {
+		return width;
+	}
+
+	/**
+	 * will retrieve the cell at position (x, y) in the board
+	 * @param x the horizontal variable (without borders as they are hidden from the user)
 	 * @param y the vertical variable (without borders as they are hidden from the user)
 	 * @return the cell at position (x,y)
 	 */	
 	T& at(int x, int y) {
+		alive_stale = true;	// the caller may change the cell
 		return board.at((x + 1) * (width + 2) + y + 1);
 	}
 
@@ -399,12 +1320,70 @@ public:
 		return board.at((x + 1) * (width + 2) + y + 1);
 	}
 
-	// 	-------------------------------------------------
+	// 	-------------------------------------------------------------
+	//	Nested Class span, the cells of one row, contiguous in memory
+	//	-------------------------------------------------------------
+	template <class T2>
+	class span {
+	public:
+
+		/**
+		 * constructor
+		 * @param first_ the first cell of the row
+		 * @param n_ the number of cells in the row
+		 */
+		span(T2* first_, int n_) : first(first_), n(n_) {}
+
+		/**
+		 * the cell at column y, not checked
+		 * @param y the column of the cell
+		 * @return a reference to the cell
+		 */
+		T2& operator[](int y) const { return first[y]; }
+
+		T2* begin() const { return first; }
+		T2* end() const { return first + n; }
+		T2* data() const { return first; }
+		int size() const { return n; }
+
+	private:
+		T2* first;			//the first cell of the row
+		int n;				//the number of cells in the row
+	};
+
+	/**
+	 * the cells of row x, for loops that read or write a whole row without checks
+	 * the span is good until the board evolves
+	 * @param x the row (without borders as they are hidden from the user)
+	 * @return the width cells of the row
+	 */
+	span<T> row(int x) {
+		alive_stale = true;	// the caller may change the cells
+		return span<T>(&board[(x + 1) * (width + 2) + 1], width);
+	}
+
+	/**
+	 * const version of row(), the cells of row x
+	 * @param x the row (without borders as they are hidden from the user)
+	 * @return the width cells of the row
+	 */
+	span<const T> row(int x) const {
+		return span<const T>(&board[(x + 1) * (width + 2) + 1], width);
+	}
+
+	// 	--------------------------------------------------------------------------
 	//	Nested Class iterator, it will iterate over board
-	//	-------------------------------------------------
+	//	a pointer into the board, it steps over the two border cells between rows,
+	//	good until the board evolves
+	//	--------------------------------------------------------------------------
 	template <class T2>
 	class iterator {
 	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef T2 value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T2* pointer;
+		typedef T2& reference;
 
 		/**
 		 * constructor
@@ -412,14 +1391,37 @@ public:
 	 	 * @param x the horizontal variable (without borders as they are hidden from the user)
 	 	 * @param y the vertical variable (without borders as they are hidden from the user)
 		 */	
-		iterator(Life& l, int x_, int y_) : life(l), x(x_), y(y_) {}
+		iterator(Life& l, int x_, int y_) :
+				base(l.board.data() + l.width + 3),
+				p(base + (std::ptrdiff_t) x_ * (l.width + 2) + y_),
+				width(l.width),
+				y(y_) {
+			l.alive_stale = true;	// the caller may change the cells
+		}
 
 		/**
 		 * operator * will override the * operator for iterator
 	 	 * @return a reference to the cell this iterator points to
 		 */	
 		T2& operator*() const {
-			return life.at(x, y);
+			return *p;
+		}
+
+		/**
+		 * operator -> will override the -> operator for iterator
+	 	 * @return a pointer to the cell this iterator points to
+		 */	
+		T2* operator->() const {
+			return p;
+		}
+
+		/**
+		 * operator [] will override the [] operator for iterator
+	 	 * @param n how many cells ahead
+	 	 * @return a reference to the cell n cells after the one this iterator points to
+		 */	
+		T2& operator[](std::ptrdiff_t n) const {
+			return *(*this + n);
 		}
 
 		/**
@@ -427,10 +1429,10 @@ public:
 	 	 * @return a reference to the iterator pointing to the next element
 		 */	
 		iterator<T2>& operator++() {
-			y++;
-			if (y >= life.width) {
-				x++;
+			++p;
+			if (++y == width) {
 				y = 0;
+				p += 2;
 			}
 			return *this;
 		}
@@ -440,20 +1442,90 @@ public:
 	 	 * @return a reference to the iterator pointing to the previous element
 		 */	
 		iterator<T2>& operator--() {
-			y--;
-			if (y < 0) {
-				x--;
-				y = life.width - 1;
+			if (y == 0) {
+				y = width;
+				p -= 2;
 			}
+			--y;
+			--p;
 			return *this;
 		}
 
+		/**
+		 * operator ++ (postfix) will iterate to the next element
+	 	 * @return a copy of the iterator before it moved
+		 */	
+		iterator<T2> operator++(int) {
+			iterator<T2> it = *this;
+			++*this;
+			return it;
+		}
+
+		/**
+		 * operator -- (postfix) will iterate to the previous element
+	 	 * @return a copy of the iterator before it moved
+		 */	
+		iterator<T2> operator--(int) {
+			iterator<T2> it = *this;
+			--*this;
+			return it;
+		}
+
+		/**
+		 * operator += will move the iterator n cells, in constant time
+	 	 * @param n how many cells to move, negative to move back
+	 	 * @return a reference to this iterator
+		 */	
+		iterator<T2>& operator+=(std::ptrdiff_t n) {
+			const std::ptrdiff_t i = index() + n;
+			y = i % width;
+			p = base + i / width * (width + 2) + y;
+			return *this;
+		}
+
+		/**
+		 * operator -= will move the iterator n cells back, in constant time
+	 	 * @param n how many cells to move back
+	 	 * @return a reference to this iterator
+		 */	
+		iterator<T2>& operator-=(std::ptrdiff_t n) {
+			return *this += -n;
+		}
+
+		/**
+		 * operator + will override the + operator for iterator
+	 	 * @param n how many cells ahead
+	 	 * @return an iterator n cells after this one
+		 */	
+		iterator<T2> operator+(std::ptrdiff_t n) const {
+			iterator<T2> it = *this;
+			return it += n;
+		}
+
+		/**
+		 * operator - will override the - operator for iterator
+	 	 * @param n how many cells back
+	 	 * @return an iterator n cells before this one
+		 */	
+		iterator<T2> operator-(std::ptrdiff_t n) const {
+			iterator<T2> it = *this;
+			return it -= n;
+		}
+
+		/**
+		 * operator - will give the distance between two iterators over the same board
+	 	 * @return how many cells rhs is before this one
+		 */	
+		std::ptrdiff_t operator-(const iterator<T2>& rhs) const {
+			return index() - rhs.index();
+		}
+
 		/**
 		 * operator == will override the == operator for iterator
 	 	 * @return a bool with the value of the comparison
 		 */	
 		bool operator==(const iterator<T2>& rhs) const {
-			return x == rhs.x && y == rhs.y && &life == &rhs.life;
+			return p == rhs.p;
 		}
 
 		/**
@@ -463,18 +1535,75 @@ public:
 		bool operator!=(const iterator<T2>& rhs) const {
 			return !(*this == rhs);
 		}
+
+		/**
+		 * operator < will override the < operator for iterator
+	 	 * @return true if this iterator is before rhs
+		 */	
+		bool operator<(const iterator<T2>& rhs) const {
+			return p < rhs.p;
+		}
+
+		/**
+		 * operator > will override the > operator for iterator
+	 	 * @return true if this iterator is after rhs
+		 */	
+		bool operator>(const iterator<T2>& rhs) const {
+			return rhs < *this;
+		}
+
+		/**
+		 * operator <= will override the <= operator for iterator
+	 	 * @return true if this iterator is not after rhs
+		 */	
+		bool operator<=(const iterator<T2>& rhs) const {
+			return !(rhs < *this);
+		}
+
+		/**
+		 * operator >= will override the >= operator for iterator
+	 	 * @return true if this iterator is not before rhs
+		 */	
+		bool operator>=(const iterator<T2>& rhs) const {
+			return !(*this < rhs);
+		}
+
+		/**
+		 * operator + with the distance first, n + it is it + n
+	 	 * @param n how many cells ahead
+	 	 * @param it the iterator
+	 	 * @return an iterator n cells after it
+		 */	
+		friend iterator<T2> operator+(std::ptrdiff_t n, const iterator<T2>& it) {
+			return it + n;
+		}
 	private:
-		Life<T2>& life;		//the board that will be iterated over
-		int x;				//current x
+		/**
+		 * the position of the cell in the board, row by row without the borders
+		 */
+		std::ptrdiff_t index() const {
+			return (p - base - y) / (width + 2) * width + y;
+		}
+
+		T2* base;			//the first cell of the board
+		T2* p;				//the current cell
+		int width;			//cells in a row
 		int y;				//current y
 	};
 
-	// 	-------------------------------------------------------
+	// 	--------------------------------------------------------------------------
 	//	Nested Class const_iterator, it will iterate over board
-	//	-------------------------------------------------------
+	//	a pointer into the board, it steps over the two border cells between rows,
+	//	good until the board evolves
+	//	--------------------------------------------------------------------------
 	template <class T2>
 	class const_iterator {
 	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef T2 value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const T2* pointer;
+		typedef const T2& reference;
 
 		/**
 		 * constructor
@@ -482,14 +1611,36 @@ public:
 	 	 * @param x the horizontal variable (without borders as they are hidden from the user)
 	 	 * @param y the vertical variable (without borders as they are hidden from the user)
 		 */	
-		const_iterator(const Life& l, int x_, int y_) : life(l), x(x_), y(y_) {}
+		const_iterator(const Life& l, int x_, int y_) :
+				base(l.board.data() + l.width + 3),
+				p(base + (std::ptrdiff_t) x_ * (l.width + 2) + y_),
+				width(l.width),
+				y(y_) {
+		}
 
 		/**
 		 * operator * will override the * operator for const_iterator
 	 	 * @return a reference to the cell this iterator points to
 		 */	
 		const T2& operator*() const {
-			return life.at(x, y);
+			return *p;
+		}
+
+		/**
+		 * operator -> will override the -> operator for const_iterator
+	 	 * @return a pointer to the cell this iterator points to
+		 */	
+		const T2* operator->() const {
+			return p;
+		}
+
+		/**
+		 * operator [] will override the [] operator for const_iterator
+	 	 * @param n how many cells ahead
+	 	 * @return a reference to the cell n cells after the one this iterator points to
+		 */	
+		const T2& operator[](std::ptrdiff_t n) const {
+			return *(*this + n);
 		}
 
 		/**
@@ -497,10 +1648,10 @@ public:
 	 	 * @return a reference to the iterator pointing to the next element
 		 */	
 		const_iterator<T2>& operator++() {
-			y++;
-			if (y >= life.width) {
-				x++;
+			++p;
+			if (++y == width) {
 				y = 0;
+				p += 2;
 			}
 			return *this;
 		}
@@ -510,20 +1661,90 @@ public:
 	 	 * @return a reference to the iterator pointing to the previous element
 		 */	
 		const_iterator<T2>& operator--() {
-			y--;
-			if (y < 0) {
-				x--;
-				y = life.width - 1;
+			if (y == 0) {
+				y = width;
+				p -= 2;
 			}
+			--y;
+			--p;
 			return *this;
 		}
 
+		/**
+		 * operator ++ (postfix) will iterate to the next element
+	 	 * @return a copy of the iterator before it moved
+		 */	
+		const_iterator<T2> operator++(int) {
+			const_iterator<T2> it = *this;
+			++*this;
+			return it;
+		}
+
+		/**
+		 * operator -- (postfix) will iterate to the previous element
+	 	 * @return a copy of the iterator before it moved
+		 */	
+		const_iterator<T2> operator--(int) {
+			const_iterator<T2> it = *this;
+			--*this;
+			return it;
+		}
+
+		/**
+		 * operator += will move the iterator n cells, in constant time
+	 	 * @param n how many cells to move, negative to move back
+	 	 * @return a reference to this iterator
+		 */	
+		const_iterator<T2>& operator+=(std::ptrdiff_t n) {
+			const std::ptrdiff_t i = index() + n;
+			y = i % width;
+			p = base + i / width * (width + 2) + y;
+			return *this;
+		}
+
+		/**
+		 * operator -= will move the iterator n cells back, in constant time
+	 	 * @param n how many cells to move back
+	 	 * @return a reference to this iterator
+		 */	
+		const_iterator<T2>& operator-=(std::ptrdiff_t n) {
+			return *this += -n;
+		}
+
+		/**
+		 * operator + will override the + operator for const_iterator
+	 	 * @param n how many cells ahead
+	 	 * @return an iterator n cells after this one
+		 */	
+		const_iterator<T2> operator+(std::ptrdiff_t n) const {
+			const_iterator<T2> it = *this;
+			return it += n;
+		}
+
+		/**
+		 * operator - will override the - operator for const_iterator
+	 	 * @param n how many cells back
+	 	 * @return an iterator n cells before this one
+		 */	
+		const_iterator<T2> operator-(std::ptrdiff_t n) const {
+			const_iterator<T2> it = *this;
+			return it -= n;
+		}
+
+		/**
+		 * operator - will give the distance between two iterators over the same board
+	 	 * @return how many cells rhs is before this one
+		 */	
+		std::ptrdiff_t operator-(const const_iterator<T2>& rhs) const {
+			return index() - rhs.index();
+		}
+
 		/**
 		 * operator == will override the == operator for const_iterator
 	 	 * @return a bool with the value of the comparison
-		 */
+		 */	
 		bool operator==(const const_iterator<T2>& rhs) const {
-			return x == rhs.x && y == rhs.y && &life == &rhs.life;
+			return p == rhs.p;
 		}
 
 		/**
@@ -533,10 +1754,60 @@ public:
 		bool operator!=(const const_iterator<T2>& rhs) const {
 			return !(*this == rhs);
 		}
+
+		/**
+		 * operator < will override the < operator for const_iterator
+	 	 * @return true if this iterator is before rhs
+		 */	
+		bool operator<(const const_iterator<T2>& rhs) const {
+			return p < rhs.p;
+		}
+
+		/**
+		 * operator > will override the > operator for const_iterator
+	 	 * @return true if this iterator is after rhs
+		 */	
+		bool operator>(const const_iterator<T2>& rhs) const {
+			return rhs < *this;
+		}
+
+		/**
+		 * operator <= will override the <= operator for const_iterator
+	 	 * @return true if this iterator is not after rhs
+		 */	
+		bool operator<=(const const_iterator<T2>& rhs) const {
+			return !(rhs < *this);
+		}
+
+		/**
+		 * operator >= will override the >= operator for const_iterator
+	 	 * @return true if this iterator is not before rhs
+		 */	
+		bool operator>=(const const_iterator<T2>& rhs) const {
+			return !(*this < rhs);
+		}
+
+		/**
+		 * operator + with the distance first, n + it is it + n
+	 	 * @param n how many cells ahead
+	 	 * @param it the iterator
+	 	 * @return an iterator n cells after it
+		 */	
+		friend const_iterator<T2> operator+(std::ptrdiff_t n, const const_iterator<T2>& it) {
+			return it + n;
+		}
 	private:
-		const Life<T2>& life;		//the board that will be iterated over
-		int x;						//current x
-		int y;						//current y
+		/**
+		 * the position of the cell in the board, row by row without the borders
+		 */
+		std::ptrdiff_t index() const {
+			return (p - base - y) / (width + 2) * width + y;
+		}
+
+		const T2* base;			//the first cell of the board
+		const T2* p;				//the current cell
+		int width;			//cells in a row
+		int y;				//current y
 	};
 
 	/*
@@ -556,31 +1827,535 @@ public:
 	}
 
 	/*
-	 * return the last element in board
-	 * @return the last element in board
+	 * return one past the last element in board, where ++ lands after the last element
+	 * @return one past the last element in board
 	 */
 	iterator<T> end() {
-		return iterator<T>(*this, height - 1, width);
+		return iterator<T>(*this, height, 0);
 	}
 
 	/*
-	 * return the last element in board
-	 * @return the last element in board
+	 * return one past the last element in board, where ++ lands after the last element
+	 * @return one past the last element in board
 	 */
 	const_iterator<T> end() const {
-		return const_iterator<T>(*this, height - 1, width);
+		return const_iterator<T>(*this, height, 0);
 	}
 private:
+	/**
+	 * decode the rows of a board straight into the board storage
+	 * every glyph is constructed once, the cells are copies of those prototypes
+	 * @param data the rows of the board, w glyphs and a newline each
+	 * @param size the number of bytes in data
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 */
+	void load(const char* data, std::size_t size, int h, int w) {
+		width = w;
+		height = h;
+		generation_ = 0;
+		population_ = 0;
+		alive_stale = true;
+		tile_size = 0;
+		origin_row_ = 0;
+		origin_col_ = 0;
+
+		board.resize((width + 2) * (height + 2), T(true)); // initialize board, fill it with borders
+
+		std::vector<T> prototypes;				//one cell per distinct glyph
+		std::vector<int> slot(256, -1);			//the prototype of each glyph, -1 until it is seen
+
+		int x = 0;
+		for (; x < height && (x + 1) * (std::size_t) (width + 1) <= size; x++) {
+			const char* row = data + x * (width + 1);
+			assert(row[width] == '\n');
+
+			T* cells = &board[(x + 1) * (width + 2) + 1];
+			for (int y = 0; y < width; y++) {
+				const unsigned char glyph = row[y];
+				assert(glyph != '\n');
+
+				if (slot[glyph] < 0) {
+					slot[glyph] = prototypes.size();
+					prototypes.push_back(T((char) glyph));
+				}
+
+				const T& cell = prototypes[slot[glyph]];
+				if (cell.is_alive())
+					population_++;
+
+				cells[y] = cell;
+			}
+		}
+
+		assert(x == height);
+
+		next_board = board;	// the back buffer shares the border ring, only its interior is rewritten
+
+		set_threads(1);
+	}
+
+	/**
+	 * rebuild the board from a checkpoint
+	 * @param data the checkpoint written by save()
+	 * @param size the number of bytes in data
+	 */
+	void restore(const char* data, std::size_t size) {
+		if (size < checkpoint_header)
+			throw std::runtime_error("not a Life checkpoint");
+		check_header(data);
+
+		height = get(data + 8, 4);
+		width = get(data + 12, 4);
+		if (size < checkpoint_size(height, width))
+			throw std::runtime_error("truncated Life checkpoint");
+
+		generation_ = get(data + 16, 8);
+		population_ = 0;
+		alive_stale = true;
+		tile_size = 0;
+		origin_row_ = 0;
+		origin_col_ = 0;
+
+		board.assign((width + 2) * (height + 2), T(true));
+
+		const char* p = data + checkpoint_header;
+		const int bytes = CellCodec<T>::bits / 8;
+		for (int x = 0; x < height; x++)
+			for (int y = 0; y < width; y++) {
+				std::uint32_t v;
+				if (bytes == 0) {
+					const long long i = (long long) x * width + y;
+					v = (p[i / 8] >> (i % 8)) & 1;
+				} else {
+					v = get(p, bytes);
+					p += bytes;
+				}
+
+				T& cell = board[(x + 1) * (width + 2) + y + 1];
+				cell = CellCodec<T>::decode(v);
+				if (cell.is_alive())
+					population_++;
+			}
+
+		if (population_ != (long long) get(data + 24, 8))
+			throw std::runtime_error("corrupt Life checkpoint, the population does not match the cells");
+
+		next_board = board;
+
+		set_threads(1);
+	}
+
+	/**
+	 * a hash of every cell of the board, from its CellCodec<T> encoding
+	 */
+	std::uint64_t state_hash() const {
+		std::uint64_t hash = 14695981039346656037ULL;	// FNV-1a
+		for (int x = 0; x < height; x++) {
+			const T* row = &board[(x + 1) * (width + 2) + 1];
+			for (int y = 0; y < width; y++)
+				hash = (hash ^ CellCodec<T>::encode(row[y])) * 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	/**
+	 * the CellCodec<T> encoding of every cell of the board, row by row
+	 */
+	void encode_cells(std::vector<std::uint32_t>& cells) const {
+		cells.clear();
+		cells.reserve(height * width);
+		for (int x = 0; x < height; x++) {
+			const T* row = &board[(x + 1) * (width + 2) + 1];
+			for (int y = 0; y < width; y++)
+				cells.push_back(CellCodec<T>::encode(row[y]));
+		}
+	}
+
+	/**
+	 * check the header of a checkpoint before anything is sized from it
+	 * the height and width must be sizes of a board, (h + 2) * (w + 2) cells indexed by an int
+	 * @param data the first checkpoint_header bytes of the checkpoint
+	 * @throws std::runtime_error if it is not the header of a checkpoint of a Life<T>
+	 */
+	static void check_header(const char* data) {
+		if (std::memcmp(data, "LIFE", 4) != 0)
+			throw std::runtime_error("not a Life checkpoint");
+		if (get(data + 4, 2) != checkpoint_version)
+			throw std::runtime_error("unknown Life checkpoint version");
+		if (get(data + 6, 1) != CellCodec<T>::kind || get(data + 7, 1) != CellCodec<T>::bits || get(data + 32, 4) != CellCodec<T>::variant)
+			throw std::runtime_error("Life checkpoint of another cell type");
+
+		const std::uint64_t h = get(data + 8, 4);
+		const std::uint64_t w = get(data + 12, 4);
+		const std::uint64_t most = std::numeric_limits<int>::max();
+		if (h > most || w > most || (h + 2) * (w + 2) > most)
+			throw std::runtime_error("Life checkpoint of an impossible size");
+	}
+
+	/**
+	 * write the low bytes of v, little endian
+	 */
+	static void put(char* p, std::uint64_t v, int bytes) {
+		for (int i = 0; i < bytes; i++)
+			p[i] = (char) (v >> (8 * i));
+	}
+
+	/**
+	 * read a little endian value of bytes bytes
+	 */
+	static std::uint64_t get(const char* p, int bytes) {
+		std::uint64_t v = 0;
+		for (int i = 0; i < bytes; i++)
+			v |= (std::uint64_t) (unsigned char) p[i] << (8 * i);
+		return v;
+	}
+
+	static const std::size_t checkpoint_header = 40;	//the size of the header of a checkpoint
+	static const int checkpoint_version = 2;			//the version save() writes
+	static const int grow_margin = 8;					//the fewest rows or columns GrowBoundary adds at once
+
+	/**
+	 * a board that does not grow stays as it is
+	 */
+	template <class B>
+	void grow(B) {}
+
+	/**
+	 * grow the board on every side that has a live cell on its edge, by a quarter of the board
+	 * or grow_margin, whichever is more, so a growing pattern is copied a logarithmic number of times
+	 * the new cells are dead_cell<T>()
+	 */
+	void grow(GrowBoundary) {
+		const int stride = width + 2;
+		bool up = false;
+		bool down = false;
+		bool left = false;
+		bool right = false;
+		for (int y = 1; y <= width; y++) {
+			up = up || board[stride + y].is_alive();
+			down = down || board[height * stride + y].is_alive();
+		}
+		for (int x = 1; x <= height; x++) {
+			left = left || board[x * stride + 1].is_alive();
+			right = right || board[x * stride + width].is_alive();
+		}
+		if (!(up || down || left || right))
+			return;
+
+		const int rows = std::max((int) grow_margin, height / 4);
+		const int cols = std::max((int) grow_margin, width / 4);
+		const int above = up ? rows : 0;
+		const int before = left ? cols : 0;
+		const int h = height + above + (down ? rows : 0);
+		const int w = width + before + (right ? cols : 0);
+
+		std::vector<T> grown((h + 2) * (w + 2), T(true));
+		const T blank = dead_cell<T>();
+		for (int x = 1; x <= h; x++)
+			std::fill(grown.begin() + x * (w + 2) + 1, grown.begin() + x * (w + 2) + w + 1, blank);
+		for (int x = 1; x <= height; x++)
+			std::copy(board.begin() + x * stride + 1, board.begin() + x * stride + width + 1,
+			          grown.begin() + (x + above) * (w + 2) + before + 1);
+
+		board.swap(grown);
+		next_board = board;
+		height = h;
+		width = w;
+		origin_row_ += above;
+		origin_col_ += before;
+		alive_stale = true;
+
+		set_threads(threads());
+		if (tile_size)
+			set_tracking(tile_size);
+	}
+
+	/**
+	 * the ring of a dead or growing board is dead border cells, there is nothing to refresh
+	 */
+	template <class B, class Dense>
+	void wrap(B, Dense) {}
+
+	/**
+	 * copy the opposite edges of the alive plane into its ring, the plane the counts are read from
+	 */
+	void wrap(TorusBoundary, std::true_type) {
+		wrap_ring(alive);
+	}
+
+	/**
+	 * copy the opposite edges of the board into its ring, the cells the neighbors are read from
+	 */
+	void wrap(TorusBoundary, std::false_type) {
+		wrap_ring(board);
+	}
+
+	/**
+	 * the first and last columns of every row, then the first and last rows, corners included
+	 * @param plane the board or its alive plane, (height + 2) rows of (width + 2)
+	 */
+	template <class U>
+	void wrap_ring(std::vector<U>& plane) {
+		const int stride = width + 2;
+		for (int x = 1; x <= height; x++) {
+			plane[x * stride] = plane[x * stride + width];
+			plane[x * stride + width + 1] = plane[x * stride + 1];
+		}
+		std::copy(plane.begin() + height * stride, plane.begin() + (height + 1) * stride, plane.begin());
+		std::copy(plane.begin() + stride, plane.begin() + 2 * stride, plane.begin() + (height + 1) * stride);
+	}
+
+	/**
+	 * nothing to set up before evolving cells that are given their neighbors
+	 */
+	void prepare(std::false_type) {}
+
+	/**
+	 * rebuild the alive plane if the board was changed through at()
+	 */
+	void prepare(std::true_type) {
+		const int stride = width + 2;
+
+		if (alive_stale) {
+			alive.assign(board.size(), 0);
+			next_alive.assign(board.size(), 0);
+			for (int x = 0; x < height; x++)
+				for (int y = 0; y < width; y++)
+					alive[(x + 1) * stride + y + 1] = board[(x + 1) * stride + y + 1].is_alive();
+			alive_stale = false;
+
+			// the back buffer no longer mirrors the unchanged tiles
+			dirty.assign(dirty.size(), 1);
+		}
+	}
+
+	/**
+	 * evolve rows [x_begin, x_end) into the back buffer, each cell is given a view of its 8 neighbors
+	 * @param x_begin the first row
+	 * @param x_end one past the last row
+	 * @param stats where the evolved cells are recorded
+	 * @return the population of the evolved rows
+	 */
+	int evolve_rows(std::false_type, int x_begin, int x_end, std::vector<unsigned char>&, Stats& stats) {
+		int live = 0;
+
+		std::ptrdiff_t offsets[8];
+		Neighborhood<T>::board_offsets(width + 2, offsets);
+
+		for (int x = x_begin; x < x_end; x++) {
+			for (int y = 0; y < width; y++) {
+				const int i = (x + 1) * (width + 2) + y + 1;
+				const T& cell = board[i];
+				const Neighborhood<T> neighbors(&cell, offsets);
+
+				T new_cell = cell + neighbors;
+				
+				if (new_cell.is_alive())
+					live++;
+
+				stats.count(x, y, cell.is_alive(), new_cell);
+				
+				next_board[i] = std::move(new_cell);
+			}
+		}
+
+		return live;
+	}
+
+	/**
+	 * evolve rows [x_begin, x_end) into the back buffer, each cell is given its live neighbor count
+	 * the counts of a whole row come from NeighborKernel<T> over the alive plane
+	 * @param x_begin the first row
+	 * @param x_end one past the last row
+	 * @param counts scratch space for the counts of one row
+	 * @param stats where the evolved cells are recorded
+	 * @return the population of the evolved rows
+	 */
+	int evolve_rows(std::true_type, int x_begin, int x_end, std::vector<unsigned char>& counts, Stats& stats) {
+		const int stride = width + 2;
+		int live = 0;
+
+		for (int x = x_begin; x < x_end; x++) {
+			const unsigned char* mid = &alive[(x + 1) * stride + 1];
+			NeighborKernel<T>::count(mid - stride, mid, mid + stride, &counts[0], width);
+
+			for (int y = 0; y < width; y++) {
+				const int i = (x + 1) * stride + y + 1;
+
+				T new_cell = board[i] + (int) counts[y];
+
+				next_alive[i] = new_cell.is_alive();
+				live += next_alive[i];
+
+				stats.count(x, y, alive[i] != 0, new_cell);
+
+				next_board[i] = std::move(new_cell);
+			}
+		}
+
+		return live;
+	}
+
+	/**
+	 * cells that are given their neighbors are never tracked, set_tracking refuses them
+	 * @return the population
+	 */
+	int evolve_active(std::false_type) {
+		return population_;
+	}
+
+	/**
+	 * evolve the tiles next to a tile that changed last generation, the others are skipped
+	 * a skipped tile did not change, so its cells in the back buffer are the same as in the board
+	 * and its statistics are the ones of the last time it was evolved, with no births or deaths
+	 * @return the population, the sum of the population of each tile
+	 */
+	int evolve_active(std::true_type) {
+		// the tiles of the opposite edges of a torus are next to each other
+		const bool torus = std::is_same<Boundary, TorusBoundary>::value;
+
+		active.clear();
+		for (int tx = 0; tx < tile_rows; tx++)
+			for (int ty = 0; ty < tile_cols; ty++) {
+				bool near_dirty = false;
+				for (int dx = tx - 1; dx <= tx + 1 && !near_dirty; dx++)
+					for (int dy = ty - 1; dy <= ty + 1 && !near_dirty; dy++) {
+						if (!torus && (dx < 0 || dy < 0 || dx >= tile_rows || dy >= tile_cols))
+							continue;
+						const int r = (dx + tile_rows) % tile_rows;
+						const int c = (dy + tile_cols) % tile_cols;
+						near_dirty = dirty[r * tile_cols + c] != 0;
+					}
+
+				if (near_dirty)
+					active.push_back(tx * tile_cols + ty);
+			}
+
+		next_dirty.assign(next_dirty.size(), 0);
+
+		const int n = active.size();
+		if (!pool)
+			evolve_tiles(0, n, band_counts[0]);
+		else {
+			// one slice of the active tiles per worker, each tile is written by one worker only
+			const int bands = pool->size();
+			pool->run([this, bands, n](int b) {
+				evolve_tiles(b * n / bands, (b + 1) * n / bands, band_counts[b]);
+			});
+		}
+
+		dirty.swap(next_dirty);
+		for (const Stats& t : tile_stats)
+			stats_.merge(t);
+		return std::accumulate(tile_population.begin(), tile_population.end(), 0);
+	}
+
+	/**
+	 * evolve active[begin, end) into the back buffer, noting which tiles changed
+	 * @param begin the first active tile
+	 * @param end one past the last active tile
+	 * @param counts scratch space for the counts of one row of a tile
+	 */
+	void evolve_tiles(int begin, int end, std::vector<unsigned char>& counts) {
+		const int stride = width + 2;
+
+		for (int k = begin; k < end; k++) {
+			const int t = active[k];
+			const int x_begin = (t / tile_cols) * tile_size;
+			const int x_end = std::min(x_begin + tile_size, height);
+			const int y_begin = (t % tile_cols) * tile_size;
+			const int y_end = std::min(y_begin + tile_size, width);
+
+			int live = 0;
+			bool changed = false;
+			Stats& stats = tile_stats[t];
+			stats.clear();
+
+			for (int x = x_begin; x < x_end; x++) {
+				const unsigned char* mid = &alive[(x + 1) * stride + y_begin + 1];
+				NeighborKernel<T>::count(mid - stride, mid, mid + stride, &counts[0], y_end - y_begin);
+
+				for (int y = y_begin; y < y_end; y++) {
+					const int i = (x + 1) * stride + y + 1;
+
+					T new_cell = board[i] + (int) counts[y - y_begin];
+
+					if (!(new_cell == board[i]))
+						changed = true;
+
+					next_alive[i] = new_cell.is_alive();
+					live += next_alive[i];
+
+					stats.count(x, y, alive[i] != 0, new_cell);
+
+					next_board[i] = std::move(new_cell);
+				}
+			}
+
+			tile_population[t] = live;
+			next_dirty[t] = changed;
+		}
+	}
+
+	/**
+	 * nothing to swap for cells that are given their neighbors
+	 */
+	void finish(std::false_type) {}
+
+	/**
+	 * the alive plane of the back buffer becomes the front one
+	 */
+	void finish(std::true_type) {
+		alive.swap(next_alive);
+	}
+
 	int height;			//max height
 	int width;			//max width
 	std::vector<T> board;	//the board itself
+	std::vector<T> next_board;	//the back buffer the next generation is written into
+
+	std::vector<unsigned char> alive;		//1 byte per board cell, 1 if alive, only used when NeighborKernel<T>::dense
+	std::vector<unsigned char> next_alive;	//the alive plane of the back buffer
+	bool alive_stale;						//the board may have changed since the alive plane was built
+
+	ThreadPoolHandle pool;									//the workers of evolve_all, null when single threaded, a copy has its own
+	std::vector<int> band_population;						//the population of each worker's band
+	std::vector<std::vector<unsigned char> > band_counts;	//each worker's row of neighbor counts
 
-	int generation;			//generation tracker
-	int population;			//population tracker
+	Stats stats_;					//the statistics of the last generation
+	mutable Probe probe_;			//the instrumentation, print is timed too
+	std::vector<Stats> band_stats;	//the statistics of each worker's band
+
+	int tile_size;							//the side of the tracked tiles, 0 when not tracking
+	int tile_rows;							//the number of rows of tiles
+	int tile_cols;							//the number of columns of tiles
+	std::vector<unsigned char> dirty;		//1 per tile, 1 if the tile changed last generation
+	std::vector<unsigned char> next_dirty;	//1 per tile, 1 if the tile changes this generation
+	std::vector<int> tile_population;		//the population of each tile
+	std::vector<Stats> tile_stats;			//the statistics of each tile
+	std::vector<int> active;				//the tiles evolved this generation
+
+	int generation_;		//generation tracker
+	int population_;		//population tracker
+
+	int origin_row_;		//the row the first row read is at, only grows with GrowBoundary
+	int origin_col_;		//the column the first column read is at, only grows with GrowBoundary
 
 	FRIEND_TEST(LifeFixture, life_construct1);
 	FRIEND_TEST(LifeFixture, life_construct2);
 	FRIEND_TEST(LifeFixture, life_construct3);
+	FRIEND_TEST(LifeFixture, life_double_buffer1);
+	FRIEND_TEST(LifeFixture, life_double_buffer2);
 };
 
+template <class T, class Stats, class Boundary, class Probe>
+const std::size_t Life<T, Stats, Boundary, Probe>::checkpoint_header;
+
+template <class T, class Stats, class Boundary, class Probe>
+const int Life<T, Stats, Boundary, Probe>::checkpoint_version;
+
+template <class T, class Stats, class Boundary, class Probe>
+const int Life<T, Stats, Boundary, Probe>::grow_margin;
+
 #endif
\ No newline at end of file
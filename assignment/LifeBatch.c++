@@ -0,0 +1,198 @@
+#include <vector>
+#include <deque>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstddef>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include "Life.h"
+#include "LifeBatch.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * the generations of one token of a header, a, a-b or a-b/s, kept as a range and not expanded
+ */
+template <class Range>
+void parse_generations(const string& token, vector<Range>& prints) {
+	char* end;
+	errno = 0;
+	const long a = strtol(token.c_str(), &end, 10);
+	long b = a;
+	long s = 1;
+	if (*end == '-') {
+		b = strtol(end + 1, &end, 10);
+		if (*end == '/')
+			s = strtol(end + 1, &end, 10);
+	}
+	if (end == token.c_str() || *end != '\0' || errno == ERANGE || a < 0 || b < a || b > INT_MAX || s < 1 || s > INT_MAX)
+		throw runtime_error("bad generation \"" + token + "\" in a LifeBatch header");
+
+	if (!prints.empty() && a <= prints.back().last)
+		throw runtime_error("the generations of a LifeBatch header have to increase");
+
+	const Range r = {(int) a, (int) (a + (b - a) / s * s), (int) s};
+	prints.push_back(r);
+}
+
+/**
+ * the glyphs a board of a kind of cell is read from
+ */
+const char* alphabet(int kind) {
+	static const char* const glyphs[] = {"*.", "-0123456789+", "*.-0123456789+"};
+	return glyphs[kind];
+}
+
+/**
+ * evolve a board to each generation to print, and print it there
+ */
+template <class T, class Range>
+string evolve_and_print(const char* data, size_t size, int h, int w, const vector<Range>& prints, const char* name) {
+	ostringstream out;
+	out << "*** Life<" << name << "> " << h << "x" << w << " ***\n" << endl;
+
+	Life<T> l(data, size, h, w);
+	int generation = 0;
+	for (const Range& r : prints)
+		for (long long g = r.first; g <= r.last; g += r.step) {
+			// one generation at a time needs no cycle detection
+			if (g - generation == 1)
+				l.evolve_all();
+			else if (g > generation)
+				l.evolve_n(g - generation);
+			generation = g;
+			l.print(out);
+		}
+	return out.str();
+}
+
+}
+
+// ---------
+// LifeBatch
+// ---------
+
+LifeBatch::LifeBatch(istream& in) : next(0) {
+	ostringstream all;
+	all << in.rdbuf();
+	input = all.str();
+
+	size_t p = 0;
+	while (true) {
+		// the blank lines between boards
+		while (p < input.size() && input[p] == '\n')
+			p++;
+		if (p == input.size())
+			break;
+
+		const size_t eol = input.find('\n', p);
+		istringstream header(input.substr(p, eol == string::npos ? string::npos : eol - p));
+		p = (eol == string::npos) ? input.size() : eol + 1;
+
+		Job job;
+		string kind;
+		if (!(header >> kind >> job.height >> job.width) || job.height < 1 || job.width < 1)
+			throw runtime_error("bad LifeBatch header");
+		if (kind == "ConwayCell")
+			job.kind = CONWAY;
+		else if (kind == "FredkinCell")
+			job.kind = FREDKIN;
+		else if (kind == "Cell")
+			job.kind = CELL;
+		else
+			throw runtime_error("unknown cell \"" + kind + "\" in a LifeBatch header");
+
+		for (string token; header >> token;)
+			parse_generations(token, job.prints);
+
+		// the rows, w glyphs of the cell and a newline each
+		job.offset = p;
+		const char* glyphs = alphabet(job.kind);
+		for (int x = 0; x < job.height; x++, p += job.width + 1) {
+			if (p + job.width >= input.size() || input[p + job.width] != '\n' || input.find('\n', p) != p + job.width)
+				throw runtime_error("a LifeBatch board is shorter or narrower than its header");
+			for (int y = 0; y < job.width; y++)
+				if (!strchr(glyphs, input[p + y]) || input[p + y] == '\0')
+					throw runtime_error("a LifeBatch board has a glyph that is not a " + kind);
+		}
+
+		jobs.push_back(job);
+	}
+}
+
+bool LifeBatch::take(vector<Queue>& queues, int i, int& job) {
+	const int n = queues.size();
+	for (int k = 0; k < n; k++) {
+		Queue& q = queues[(i + k) % n];
+		lock_guard<mutex> l(q.lock);
+		if (q.jobs.empty())
+			continue;
+
+		if (k == 0) {
+			job = q.jobs.front();
+			q.jobs.pop_front();
+		} else {
+			job = q.jobs.back();
+			q.jobs.pop_back();
+		}
+		return true;
+	}
+	return false;
+}
+
+string LifeBatch::render(const Job& job) const {
+	const char* data = input.data() + job.offset;
+	const size_t size = (size_t) job.height * (job.width + 1);
+
+	switch (job.kind) {
+	case CONWAY:
+		return evolve_and_print<ConwayCell>(data, size, job.height, job.width, job.prints, "ConwayCell");
+	case FREDKIN:
+		return evolve_and_print<FredkinCell>(data, size, job.height, job.width, job.prints, "FredkinCell");
+	case CELL:
+		return evolve_and_print<Cell>(data, size, job.height, job.width, job.prints, "Cell");
+	}
+	return string();
+}
+
+void LifeBatch::complete(int job, string& text, ostream& out) {
+	lock_guard<mutex> l(output_lock);
+	results[job].swap(text);
+	ready[job] = 1;
+	for (; next < jobs.size() && ready[next]; next++) {
+		out.write(results[next].data(), results[next].size());
+		string().swap(results[next]);
+	}
+}
+
+void LifeBatch::run(ostream& out, int threads) {
+	if (threads < 1)
+		threads = 1;
+
+	results.assign(jobs.size(), string());
+	ready.assign(jobs.size(), 0);
+	next = 0;
+
+	// dealt out round robin, so the first boards in order are the first ones started
+	vector<Queue> queues(threads);
+	for (size_t j = 0; j < jobs.size(); j++)
+		queues[j % threads].jobs.push_back(j);
+
+	ThreadPool pool(threads);
+	pool.run([this, &queues, &out](int i) {
+		int job;
+		while (take(queues, i, job)) {
+			string text = render(jobs[job]);
+			complete(job, text, out);
+		}
+	});
+}
@@ -0,0 +1,105 @@
+#ifndef LifeBatch_h
+#define LifeBatch_h
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <iostream>
+#include <mutex>
+#include <cstddef>
+
+// 	-------------------------------------------------------------------------
+//	Class LifeBatch runs many boards read from one stream, in the format of
+//	RunLife.in with a header line above every board:
+//
+//		<cell> <height> <width> <generation>...
+//
+//	<cell> is ConwayCell, FredkinCell or Cell, and each <generation> to print
+//	is a number, a range a-b or a range with a step a-b/s, in increasing
+//	order. The whole stream is read in one pass and the boards are decoded
+//	straight from it. The boards are dealt out to the workers, and a worker
+//	that runs out steals from the back of another's queue, so a few big
+//	boards do not hold up the rest. The output of every board is written in
+//	input order, through a reorder buffer, as soon as it and all the boards
+//	before it are done: the output is the same with any number of workers.
+// 	-------------------------------------------------------------------------
+class LifeBatch {
+public:
+
+	/**
+	 * constructor, reads and checks every board of the stream
+	 * @param in the istream to read from
+	 * @throws std::runtime_error if a header or a board is malformed
+	 */
+	explicit LifeBatch(std::istream& in);
+
+	/**
+	 * evolve every board and write its generations, each board after a line "*** Life<cell> hxw ***"
+	 * @param out the ostream to write to
+	 * @param threads the number of workers, the calling thread is one of them
+	 */
+	void run(std::ostream& out, int threads);
+
+	/**
+	 * how many boards were read?
+	 * @return the number of boards
+	 */
+	int size() const { return jobs.size(); }
+
+private:
+	enum Kind { CONWAY, FREDKIN, CELL };
+
+	// 	------------------------------------------------------------------
+	//	Range is one token of a header, generations first to last by step
+	// 	------------------------------------------------------------------
+	struct Range {
+		int first;	//the first generation printed
+		int last;	//the last generation printed, first + a whole number of steps
+		int step;	//the distance between two generations printed
+	};
+
+	// 	---------------------------------------------
+	//	Job is one board and the generations to print
+	// 	---------------------------------------------
+	struct Job {
+		Kind kind;					//the cell of the board
+		int height;					//height of the board
+		int width;					//width of the board
+		std::vector<Range> prints;	//the generations to print, in increasing order
+		std::size_t offset;			//where the rows of the board start in input
+	};
+
+	// 	-------------------------------------------------------
+	//	Queue is the jobs of one worker, others steal from back
+	// 	-------------------------------------------------------
+	struct Queue {
+		std::mutex lock;
+		std::deque<int> jobs;
+	};
+
+	/**
+	 * the next job for worker i, its own first, then the last one of another worker
+	 * @return false once every queue is empty
+	 */
+	bool take(std::vector<Queue>& queues, int i, int& job);
+
+	/**
+	 * evolve one board and render everything it prints
+	 */
+	std::string render(const Job& job) const;
+
+	/**
+	 * hand in the output of a job, and write every output that is next in order
+	 */
+	void complete(int job, std::string& text, std::ostream& out);
+
+	std::string input;			//the whole stream, the boards are decoded from it
+	std::vector<Job> jobs;		//every board, in input order
+
+	std::mutex output_lock;				//guards everything below
+	std::vector<std::string> results;	//the output of each job that is done but not written
+	std::vector<char> ready;			//1 if the job is done
+	std::size_t next;					//the first job not written yet
+};
+
+#endif
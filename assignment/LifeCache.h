@@ -0,0 +1,233 @@
+#ifndef LifeCache_h
+#define LifeCache_h
+
+#include <vector>
+#include <map>
+#include <string>
+#include <iostream>
+#include <unordered_map>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "Life.h"
+
+// 	--------------------------------------------------------------------------
+//	Generic Class LifeCache remembers the boards it has evolved, keyed by the
+//	text they were read from, so a board read again from the same text does
+//	not have to be evolved from generation 0 again. For every distinct text
+//	it keeps the population of every generation computed so far and a
+//	checkpoint (Life<T>::save) every every generations. A cursor opened on a
+//	text that was seen before jumps to the last checkpoint at or before the
+//	generation it is asked for and only evolves the rest.
+//
+//	The key is a hash of the cell type, the size and the text of the board;
+//	the text is kept too, so two texts with the same hash never share an
+//	entry.
+// 	--------------------------------------------------------------------------
+template <class T>
+class LifeCache {
+	// 	------------------------------------------------------------
+	//	Entry is everything known about the boards of one text
+	// 	------------------------------------------------------------
+	struct Entry {
+		std::string text;						//the text of the board
+		int height;								//height of the board
+		int width;								//width of the board
+		std::vector<int> populations;			//the population of each generation, -1 until computed
+		std::map<int, std::string> checkpoints;	//the checkpoints, by generation
+	};
+
+public:
+
+	// 	--------------------------------------------------------------------
+	//	Nested Class cursor, a board read through the cache, every generation
+	//	it goes through is recorded in the cache
+	// 	--------------------------------------------------------------------
+	class cursor {
+	public:
+
+		/**
+		 * evolve the board to generation g, from the last checkpoint at or before g if there is one ahead of it
+		 * @param g the generation, no less than the current one
+		 */
+		void evolve_to(int g) {
+			assert(g >= board.generation());
+			Entry& e = cache->entries[entry];
+
+			typename std::map<int, std::string>::const_iterator c = e.checkpoints.upper_bound(g);
+			if (c != e.checkpoints.begin() && (--c)->first > board.generation()) {
+				cache->reused_ += c->first - board.generation();
+				board = Life<T>(c->second.data(), c->second.size());
+			}
+
+			while (board.generation() < g) {
+				board.evolve_all();
+				cache->record(e, board);
+			}
+		}
+
+		/**
+		 * evolve the board one generation
+		 */
+		void evolve_all() {
+			evolve_to(board.generation() + 1);
+		}
+
+		/**
+		 * the population of any generation this text was evolved to, by this cursor or another one
+		 * @param g the generation
+		 * @return the population, -1 if generation g was never computed
+		 */
+		int population_at(int g) const {
+			const std::vector<int>& p = cache->entries[entry].populations;
+			return g >= 0 && g < (int) p.size() ? p[g] : -1;
+		}
+
+		/**
+		 * the board at its current generation
+		 * @return the board
+		 */
+		const Life<T>& life() const { return board; }
+
+		void print(std::ostream& out) const { board.print(out); }
+		int generation() const { return board.generation(); }
+		int population() const { return board.population(); }
+
+	private:
+		friend class LifeCache;
+
+		cursor(LifeCache* c, int e, const Entry& text) :
+				cache(c),
+				entry(e),
+				board(text.text.data(), text.text.size(), text.height, text.width) {
+		}
+
+		LifeCache* cache;	//the cache the generations are recorded in
+		int entry;			//the entry of the text
+		Life<T> board;		//the board
+	};
+
+	/**
+	 * constructor
+	 * @param every_ the distance between two checkpoints, in generations
+	 */
+	explicit LifeCache(int every_ = 64) : every(every_), reused_(0) {
+		assert(every > 0);
+	}
+
+	/**
+	 * read a board and open a cursor on it, at generation 0
+	 * @param in the istream to read from, the same text Life<T> reads
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 * @return the cursor
+	 */
+	cursor open(std::istream& in, int h, int w) {
+		const std::size_t size = (std::size_t) h * (w + 1);
+		std::string text(size, '\0');
+		in.read(&text[0], text.size());
+		text.resize(in.gcount());
+
+		// the blank line that ends the board
+		if (text.size() == size && in.peek() == '\n')
+			in.get();
+
+		return open(text.data(), text.size(), h, w);
+	}
+
+	/**
+	 * open a cursor on a board held in memory, at generation 0
+	 * @param data the text of the board, in the format the istream constructor of Life<T> reads
+	 * @param size the number of bytes in data
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 * @return the cursor
+	 */
+	cursor open(const char* data, std::size_t size, int h, int w) {
+		// the same board with or without the blank line after it
+		size = std::min(size, (std::size_t) h * (w + 1));
+		const std::uint64_t key = hash(data, size, h, w);
+
+		typedef typename std::unordered_multimap<std::uint64_t, int>::const_iterator iterator;
+		const std::pair<iterator, iterator> range = index.equal_range(key);
+		for (iterator it = range.first; it != range.second; ++it) {
+			const Entry& e = entries[it->second];
+			if (e.height == h && e.width == w && e.text.size() == size && e.text.compare(0, size, data, size) == 0)
+				return cursor(this, it->second, e);
+		}
+
+		Entry e;
+		e.text.assign(data, size);
+		e.height = h;
+		e.width = w;
+		entries.push_back(e);
+		index.insert(std::make_pair(key, (int) entries.size() - 1));
+
+		cursor c(this, entries.size() - 1, entries.back());
+		record(entries.back(), c.board);
+		return c;
+	}
+
+	/**
+	 * how many distinct boards are cached?
+	 * @return the number of entries
+	 */
+	int size() const { return entries.size(); }
+
+	/**
+	 * how many generations were restored from a checkpoint instead of evolved?
+	 * @return the number of generations
+	 */
+	long long reused() const { return reused_; }
+
+	/**
+	 * how many bytes do the checkpoints take?
+	 * @return the number of bytes
+	 */
+	std::size_t checkpoint_bytes() const {
+		std::size_t bytes = 0;
+		for (const Entry& e : entries)
+			for (const std::pair<const int, std::string>& c : e.checkpoints)
+				bytes += c.second.size();
+		return bytes;
+	}
+
+private:
+	/**
+	 * FNV-1a of the cell type, the size and the text of a board
+	 */
+	static std::uint64_t hash(const char* data, std::size_t size, int h, int w) {
+		std::uint64_t key = 14695981039346656037ULL;
+		const std::uint64_t head[] = {CellCodec<T>::kind, (std::uint64_t) h, (std::uint64_t) w};
+		for (std::uint64_t v : head)
+			key = (key ^ v) * 1099511628211ULL;
+		for (std::size_t i = 0; i < size; i++)
+			key = (key ^ (unsigned char) data[i]) * 1099511628211ULL;
+		return key;
+	}
+
+	/**
+	 * record the population of the generation a board is at, and its checkpoint every every generations
+	 */
+	void record(Entry& e, const Life<T>& board) {
+		const int g = board.generation();
+		if ((int) e.populations.size() <= g)
+			e.populations.resize(g + 1, -1);
+		e.populations[g] = board.population();
+
+		if (g % every == 0 && g > 0 && !e.checkpoints.count(g)) {
+			std::string& c = e.checkpoints[g];
+			c.resize(Life<T>::checkpoint_size(board.rows(), board.cols()));
+			board.save(&c[0]);
+		}
+	}
+
+	int every;										//the distance between two checkpoints
+	std::vector<Entry> entries;						//every distinct board, in the order they were seen
+	std::unordered_multimap<std::uint64_t, int> index;	//the entries of each key
+	long long reused_;								//generations restored from checkpoints
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "LifeProbe.h"
+
+using namespace std;
+
+// ----------
+// ProbeEvent
+// ----------
+
+const char* ProbeEvent::name() const {
+	switch (kind) {
+	case LOAD:
+		return "load";
+	case EVOLVE:
+		return "evolve_all";
+	case PRINT:
+		return "print";
+	}
+	return "";
+}
+
+// ---------
+// LifeProbe
+// ---------
+
+LifeProbe::LifeProbe() :
+		origin(clock::now()),
+		started(origin),
+		allocations_at_start(0),
+		allocation_counter(nullptr),
+		keep_(true) {
+}
+
+void LifeProbe::begin() {
+	if (allocation_counter)
+		allocations_at_start = allocation_counter->load(memory_order_relaxed);
+	started = clock::now();
+}
+
+void LifeProbe::finish(ProbeEvent::Kind kind, int generation, int population, long long cells, long long skipped, size_t bytes) {
+	const clock::time_point now = clock::now();
+
+	ProbeEvent e;
+	e.kind = kind;
+	e.generation = generation;
+	e.population = population;
+	e.start = chrono::duration<double, micro>(started - origin).count();
+	e.duration = chrono::duration<double, micro>(now - started).count();
+	e.cells = cells;
+	e.skipped = skipped;
+	e.bytes = bytes;
+	e.allocations = allocation_counter ? allocation_counter->load(memory_order_relaxed) - allocations_at_start : -1;
+
+	if (callback)
+		callback(e);
+	if (keep_)
+		events_.push_back(e);
+}
+
+void LifeProbe::write_trace(ostream& out) const {
+	// microseconds to the nanosecond, never in scientific notation
+	const ios_base::fmtflags flags = out.flags();
+	const streamsize precision = out.precision();
+	out << fixed << setprecision(3);
+
+	out << "{\"traceEvents\":[";
+	const char* separator = "\n";
+	for (const ProbeEvent& e : events_) {
+		out << separator << "{\"name\":\"" << e.name() << "\",\"cat\":\"life\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+		    << ",\"ts\":" << e.start << ",\"dur\":" << e.duration
+		    << ",\"args\":{\"generation\":" << e.generation << ",\"population\":" << e.population;
+		if (e.kind == ProbeEvent::PRINT)
+			out << ",\"bytes\":" << e.bytes;
+		else
+			out << ",\"cells\":" << e.cells << ",\"skipped\":" << e.skipped;
+		if (e.allocations >= 0)
+			out << ",\"allocations\":" << e.allocations;
+		out << "}}";
+		separator = ",\n";
+
+		if (e.kind != ProbeEvent::PRINT)
+			out << separator << "{\"name\":\"population\",\"cat\":\"life\",\"ph\":\"C\",\"pid\":1,\"tid\":1"
+			    << ",\"ts\":" << e.start + e.duration << ",\"args\":{\"population\":" << e.population << "}}";
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	out.flags(flags);
+	out.precision(precision);
+}
@@ -0,0 +1,139 @@
+#ifndef LifeProbe_h
+#define LifeProbe_h
+
+#include <vector>
+#include <iostream>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <cstddef>
+
+// 	-------------------------------------------------------------------------
+//	ProbeEvent is one timed call into a board: its construction, a generation
+//	of evolve_all or a print
+// 	-------------------------------------------------------------------------
+struct ProbeEvent {
+	enum Kind { LOAD, EVOLVE, PRINT };
+
+	Kind kind;				//what was timed
+	int generation;			//the generation of the board when it was done
+	int population;			//the population of the board when it was done
+	double start;			//microseconds from the making of the probe to the start
+	double duration;		//microseconds it took
+	long long cells;		//cells read by LOAD, cells evolved by EVOLVE
+	long long skipped;		//cells EVOLVE left alone because they could not change
+	std::size_t bytes;		//bytes written by PRINT
+	long long allocations;	//calls to operator new while it ran, -1 if they are not counted
+
+	/**
+	 * the name of the event in a trace, the name of the call
+	 * @return "load", "evolve_all" or "print"
+	 */
+	const char* name() const;
+};
+
+// 	-------------------------------------------------------------------------
+//	Class LifeProbe is the instrumentation policy that times a board, given
+//	to Life<T, Stats, Boundary, LifeProbe> and reached through probe(). Every
+//	event goes to the callback, if there is one, and is kept for write_trace
+//	unless keep_events(false) was called. Allocations are only counted when
+//	the program counts them itself, by replacing operator new, and hands the
+//	counter to count_allocations.
+// 	-------------------------------------------------------------------------
+class LifeProbe {
+public:
+	typedef std::function<void(const ProbeEvent&)> Callback;
+
+	/**
+	 * constructor, the start of every event is measured from now
+	 */
+	LifeProbe();
+
+	/**
+	 * send every event to a callback, as soon as it is done
+	 * @param c the callback, an empty one sends nothing
+	 */
+	void set_callback(const Callback& c) { callback = c; }
+
+	/**
+	 * count allocations with a counter the program increments in operator new
+	 * @param counter the counter, null stops counting
+	 */
+	void count_allocations(const std::atomic<long long>* counter) { allocation_counter = counter; }
+
+	/**
+	 * keep the events for events() and write_trace, or only send them to the callback
+	 * @param keep true to keep them
+	 */
+	void keep_events(bool keep) { keep_ = keep; }
+
+	/**
+	 * every event kept, oldest first
+	 */
+	const std::vector<ProbeEvent>& events() const { return events_; }
+
+	/**
+	 * forget the events kept
+	 */
+	void clear() { events_.clear(); }
+
+	/**
+	 * write the events kept in the Chrome trace event format, read by chrome://tracing and Perfetto
+	 * every event is a complete ("X") event, with a population counter ("C") after each generation
+	 * @param out the ostream to write to
+	 */
+	void write_trace(std::ostream& out) const;
+
+	/**
+	 * the hooks Life calls, a *ing before the work and the *ed after it
+	 */
+	void loading() { begin(); }
+
+	template <class L>
+	void loaded(const L& life) {
+		end(ProbeEvent::LOAD, life, (long long) life.rows() * life.cols(), 0, 0);
+	}
+
+	void evolving() { begin(); }
+
+	template <class L>
+	void evolved(const L& life) {
+		const long long cells = life.evolved_cells();
+		end(ProbeEvent::EVOLVE, life, cells, (long long) life.rows() * life.cols() - cells, 0);
+	}
+
+	void printing() { begin(); }
+
+	template <class L>
+	void printed(const L& life, std::size_t bytes) {
+		end(ProbeEvent::PRINT, life, 0, 0, bytes);
+	}
+
+private:
+	typedef std::chrono::steady_clock clock;
+
+	/**
+	 * start timing an event
+	 */
+	void begin();
+
+	/**
+	 * finish timing an event, then send and keep it
+	 */
+	template <class L>
+	void end(ProbeEvent::Kind kind, const L& life, long long cells, long long skipped, std::size_t bytes) {
+		finish(kind, life.generation(), life.population(), cells, skipped, bytes);
+	}
+
+	void finish(ProbeEvent::Kind kind, int generation, int population, long long cells, long long skipped, std::size_t bytes);
+
+	clock::time_point origin;							//the time the start of every event is measured from
+	clock::time_point started;							//the start of the event being timed
+	long long allocations_at_start;						//the allocation counter when it started
+	const std::atomic<long long>* allocation_counter;	//operator new calls of the program, null if not counted
+	Callback callback;									//where every event is sent, empty for nowhere
+	bool keep_;											//keep the events for write_trace?
+	std::vector<ProbeEvent> events_;					//the events kept, oldest first
+};
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef LutLife_h
+#define LutLife_h
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "RuleCell.h"
+
+// 	--------------------------------------------------------------------------
+//	Generic Class LutLife evolves a board of RuleCells 2x2 cells at a time,
+//	with a table of the 65536 4x4 squares of cells: each square is a 16 bit
+//	index and its entry is the center 2x2 one generation later. Along a pair
+//	of rows the index slides right two columns at a time, keeping 2 of the 4
+//	columns it had and reading 2 more, so a block costs 8 loads and one table
+//	lookup, with no branch on the cells. The entries are computed by block(),
+//	a constexpr function of Rule::next, so the table and the rule can not
+//	disagree. Like Life<T>, the cells outside the board are dead forever.
+// 	--------------------------------------------------------------------------
+template <class Rule = ConwayRule>
+class LutLife {
+public:
+
+	/**
+	 * constructor
+	 * @param in the istream to read from, a board of * and .
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 */
+	LutLife(std::istream& in, int h, int w) : height(h), width(w), generation_(0), population_(0) {
+		// a dead row and column of padding when h or w is odd, so the board is whole blocks
+		rows = h + (h & 1);
+		stride = w + (w & 1) + 2;
+		board.resize((rows + 2) * stride, 0);
+
+		int x = 0;
+		int y = 0;
+
+		while (true) {
+			int input = in.get();
+
+			if (input == EOF || (input == '\n' && y == 0))
+				break;
+
+			if (input == '\n') {
+				x++;
+				assert(y == width);
+				y = 0;
+				continue;
+			}
+
+			const bool alive = Rule((char) input).is_alive();
+			population_ += alive;
+			board[(x + 1) * stride + y + 1] = alive;
+
+			y++;
+		}
+
+		assert(x == height);
+
+		next_board = board;
+	}
+
+	/**
+	 * print the board, same format as Life<Rule>::print
+	 * @param out the ostream to write to
+	 */
+	void print(std::ostream& out) const {
+		std::string text = "Generation = " + std::to_string(generation_) + ", Population = " + std::to_string(population_) + ".\n";
+		const std::size_t header = text.size();
+
+		text.resize(header + (std::size_t) height * (width + 1) + 1, '\n');
+		char* p = &text[header];
+		for (int x = 0; x < height; x++, p++) {
+			const unsigned char* row = &board[(x + 1) * stride + 1];
+			for (int y = 0; y < width; y++)
+				*p++ = row[y] ? '*' : '.';
+		}
+
+		out.write(text.data(), text.size());
+	}
+
+	/**
+	 * evolve every cell of the board, a 2x2 block at a time
+	 */
+	void evolve_all() {
+		const unsigned char* lut = table();
+		const int blocks = (stride - 2) / 2;
+
+		// the padding row and column are kept dead
+		const unsigned bottom_mask = (height & 1) ? 0xc : 0xf;
+		const unsigned right_mask = (width & 1) ? 0xa : 0xf;
+
+		population_ = 0;
+		for (int x = 0; x < rows; x += 2) {
+			// the four rows of the squares, x - 1 to x + 2
+			const unsigned char* r0 = &board[x * stride];
+			const unsigned char* r1 = r0 + stride;
+			const unsigned char* r2 = r1 + stride;
+			const unsigned char* r3 = r2 + stride;
+			unsigned char* out0 = &next_board[(x + 1) * stride + 1];
+			unsigned char* out1 = out0 + stride;
+			const unsigned row_mask = x + 2 == rows ? bottom_mask : 0xf;
+
+			// columns -1 to 2 of the first square
+			unsigned index = 0;
+			for (int c = 0; c < 4; c++)
+				index |= (r0[c] << 15 | r1[c] << 11 | r2[c] << 7 | r3[c] << 3) >> c;
+
+			for (int b = 0; b < blocks; b++) {
+				unsigned next = lut[index] & row_mask;
+				if (b + 1 == blocks)
+					next &= right_mask;
+				else {
+					// slide two columns right, columns 2 and 3 of the next square are read
+					const int c = 2 * b + 4;
+					index = ((index << 2) & 0xcccc) |
+					        r0[c] << 13 | r0[c + 1] << 12 | r1[c] << 9 | r1[c + 1] << 8 |
+					        r2[c] << 5 | r2[c + 1] << 4 | r3[c] << 1 | r3[c + 1];
+				}
+
+				out0[2 * b] = next >> 3;
+				out0[2 * b + 1] = (next >> 2) & 1;
+				out1[2 * b] = (next >> 1) & 1;
+				out1[2 * b + 1] = next & 1;
+				population_ += (next >> 3) + ((next >> 2) & 1) + ((next >> 1) & 1) + (next & 1);
+			}
+		}
+
+		board.swap(next_board);
+		generation_++;
+	}
+
+	/**
+	 * evolve the board n generations
+	 * @param n the number of generations
+	 */
+	void evolve(int n) {
+		for (int i = 0; i < n; i++)
+			evolve_all();
+	}
+
+	/**
+	 * will retrieve the cell at position (x, y) in the board
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @return a copy of the cell at position (x,y)
+	 */
+	Rule at(int x, int y) const {
+		assert(x >= 0 && x < height && y >= 0 && y < width);
+		return Rule(board[(x + 1) * stride + y + 1] ? '*' : '.');
+	}
+
+	/**
+	 * how many cells are alive?
+	 * @return the population
+	 */
+	int population() const { return population_; }
+
+	/**
+	 * what generation is the board at?
+	 * @return the generation
+	 */
+	int generation() const { return generation_; }
+
+	/**
+	 * the center 2x2 of a 4x4 square one generation later, the entry of the table
+	 * bit 15 - 4r - c of the index is the cell at row r, column c of the square,
+	 * the result has bit 3 for its top left cell, then top right, bottom left and bottom right
+	 * @param index the 16 cells of the square
+	 * @return the 4 cells of the center
+	 */
+	static constexpr unsigned block(unsigned index) {
+		return Rule::next(cell(index, 1, 1), count(index, 1, 1)) << 3 |
+		       Rule::next(cell(index, 1, 2), count(index, 1, 2)) << 2 |
+		       Rule::next(cell(index, 2, 1), count(index, 2, 1)) << 1 |
+		       Rule::next(cell(index, 2, 2), count(index, 2, 2));
+	}
+
+private:
+	/**
+	 * the cell at row r, column c of a square
+	 */
+	static constexpr int cell(unsigned index, int r, int c) {
+		return (index >> (15 - 4 * r - c)) & 1;
+	}
+
+	/**
+	 * the live neighbors of the cell at row r, column c of a square, in the neighborhood of Rule
+	 */
+	static constexpr int count(unsigned index, int r, int c) {
+		return cell(index, r - 1, c) + cell(index, r, c - 1) + cell(index, r, c + 1) + cell(index, r + 1, c) +
+		       (std::is_same<typename Rule::neighborhood, VonNeumann>::value ? 0 :
+		        cell(index, r - 1, c - 1) + cell(index, r - 1, c + 1) + cell(index, r + 1, c - 1) + cell(index, r + 1, c + 1));
+	}
+
+	/**
+	 * the table of every square, built the first time a board of Rule evolves
+	 */
+	static const unsigned char* table() {
+		static const std::vector<unsigned char> lut = build();
+		return lut.data();
+	}
+
+	static std::vector<unsigned char> build() {
+		std::vector<unsigned char> lut(1 << 16);
+		for (unsigned i = 0; i < lut.size(); i++)
+			lut[i] = block(i);
+		return lut;
+	}
+
+	int height;			//max height
+	int width;			//max width
+	int rows;			//height, one more if it is odd
+	int stride;			//cells in a row of the board, width padded to a whole block and its ring
+	std::vector<unsigned char> board;		//(rows + 2) rows of stride cells, 1 for alive, the ring and padding are dead
+	std::vector<unsigned char> next_board;	//the back buffer the next generation is written into
+
+	int generation_;	//generation tracker
+	int population_;	//population tracker
+};
+
+#endif
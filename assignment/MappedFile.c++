@@ -0,0 +1,71 @@
+#include <string>
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+MappedFile::MappedFile(const string& path) : fd(-1), bytes(nullptr), length(0) {
+	fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw system_error(errno, generic_category(), path);
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		const int error = errno;
+		close(fd);
+		throw system_error(error, generic_category(), path);
+	}
+	length = st.st_size;
+
+	map(false, path);
+
+	// boards are read from the first row to the last
+	if (bytes)
+		madvise(bytes, length, MADV_SEQUENTIAL);
+}
+
+MappedFile::MappedFile(const string& path, size_t size) : fd(-1), bytes(nullptr), length(size) {
+	fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		throw system_error(errno, generic_category(), path);
+
+	if (ftruncate(fd, size) < 0) {
+		const int error = errno;
+		close(fd);
+		throw system_error(error, generic_category(), path);
+	}
+
+	map(true, path);
+}
+
+void MappedFile::map(bool writable, const string& path) {
+	// mmap refuses empty mappings, an empty file has no bytes
+	if (length == 0)
+		return;
+
+	void* p = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		const int error = errno;
+		close(fd);
+		throw system_error(error, generic_category(), path);
+	}
+	bytes = static_cast<char*>(p);
+}
+
+MappedFile::~MappedFile() {
+	if (bytes)
+		munmap(bytes, length);
+	close(fd);
+}
+
+void MappedFile::sync() {
+	if (bytes && msync(bytes, length, MS_SYNC) < 0)
+		throw system_error(errno, generic_category(), "msync");
+}
@@ -0,0 +1,74 @@
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <string>
+#include <cstddef>
+
+// 	-------------------------------------------------------------------------
+//	Class MappedFile maps a whole file into memory, so a board can be read
+//	with Life(const char*, std::size_t, int, int) and written with
+//	Life::print(char*) without going through a stream or a copy of the file
+// 	-------------------------------------------------------------------------
+class MappedFile {
+public:
+
+	/**
+	 * constructor, maps an existing file read only
+	 * @param path the file to map
+	 * @throws std::system_error if the file cannot be opened or mapped
+	 */
+	explicit MappedFile(const std::string& path);
+
+	/**
+	 * constructor, creates (or truncates) a file of size bytes and maps it read write
+	 * @param path the file to map
+	 * @param size the size of the file in bytes
+	 * @throws std::system_error if the file cannot be created or mapped
+	 */
+	MappedFile(const std::string& path, std::size_t size);
+
+	/**
+	 * destructor, unmaps and closes the file, writes to a read write mapping reach the file
+	 */
+	~MappedFile();
+
+	/**
+	 * the first byte of the file
+	 * @return a pointer to the mapped bytes, null for an empty file
+	 */
+	const char* data() const { return bytes; }
+
+	/**
+	 * the first byte of the file, only writable if the file was mapped read write
+	 * @return a pointer to the mapped bytes, null for an empty file
+	 */
+	char* data() { return bytes; }
+
+	/**
+	 * how big is the file?
+	 * @return the size of the file in bytes
+	 */
+	std::size_t size() const { return length; }
+
+	/**
+	 * write the changed pages back to the file and wait for them
+	 * @throws std::system_error if the pages cannot be written
+	 */
+	void sync();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+	/**
+	 * map length bytes of fd
+	 * @param writable true to map read write, false to map read only
+	 */
+	void map(bool writable, const std::string& path);
+
+	int fd;					//the file descriptor of the mapped file
+	char* bytes;			//the mapping, null if the file is empty
+	std::size_t length;		//the size of the mapping
+};
+
+#endif
@@ -0,0 +1,309 @@
+#include "NeighborCount.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LIFE_X86 1
+#include <immintrin.h>
+#endif
+
+// ------
+// scalar
+// ------
+
+namespace {
+
+void moore_scalar(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int i, int n) {
+	for (; i < n; i++)
+		out[i] = (up[i - 1] & 1) + (up[i] & 1) + (up[i + 1] & 1) +
+		         (mid[i - 1] & 1) + (mid[i + 1] & 1) +
+		         (down[i - 1] & 1) + (down[i] & 1) + (down[i + 1] & 1);
+}
+
+void von_neumann_scalar(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int i, int n) {
+	for (; i < n; i++)
+		out[i] = (up[i] & 1) + (mid[i - 1] & 1) + (mid[i + 1] & 1) + (down[i] & 1);
+}
+
+void fredkin_scalar(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int i, int n) {
+	for (; i < n; i++) {
+		// alive next with 1 or 3 live neighbors, a cell that stays alive gets one older
+		const int alive = ((up[i] & 1) + (mid[i - 1] & 1) + (mid[i + 1] & 1) + (down[i] & 1)) & 1;
+		const int aged = (mid[i] & 0xfe) + ((mid[i] & alive) << 1);
+		out[i] = (aged > 0xfe ? 0xfe : aged) | alive;
+	}
+}
+
+void moore0_scalar(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	moore_scalar(up, mid, down, out, 0, n);
+}
+
+void von_neumann0_scalar(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	von_neumann_scalar(up, mid, down, out, 0, n);
+}
+
+void fredkin0_scalar(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	fredkin_scalar(up, mid, down, out, 0, n);
+}
+
+#ifdef LIFE_X86
+
+// ----
+// sse2
+// ----
+
+__attribute__((target("sse2")))
+void moore_sse2(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m128i one = _mm_set1_epi8(1);
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i s = _mm_and_si128(_mm_loadu_si128((const __m128i*) (up + i - 1)), one);
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (up + i)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (up + i + 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (mid + i - 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (mid + i + 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (down + i - 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (down + i)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (down + i + 1)), one));
+		_mm_storeu_si128((__m128i*) (out + i), s);
+	}
+	moore_scalar(up, mid, down, out, i, n);
+}
+
+__attribute__((target("sse2")))
+void von_neumann_sse2(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m128i one = _mm_set1_epi8(1);
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i s = _mm_and_si128(_mm_loadu_si128((const __m128i*) (up + i)), one);
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (mid + i - 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (mid + i + 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (down + i)), one));
+		_mm_storeu_si128((__m128i*) (out + i), s);
+	}
+	von_neumann_scalar(up, mid, down, out, i, n);
+}
+
+__attribute__((target("sse2")))
+void fredkin_sse2(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m128i one = _mm_set1_epi8(1);
+	const __m128i age = _mm_set1_epi8((char) 0xfe);
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i s = _mm_and_si128(_mm_loadu_si128((const __m128i*) (up + i)), one);
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (mid + i - 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (mid + i + 1)), one));
+		s = _mm_add_epi8(s, _mm_and_si128(_mm_loadu_si128((const __m128i*) (down + i)), one));
+		const __m128i alive = _mm_and_si128(s, one);
+
+		// the saturating add stops the age at 127
+		const __m128i c = _mm_loadu_si128((const __m128i*) (mid + i));
+		const __m128i older = _mm_and_si128(c, alive);
+		const __m128i aged = _mm_and_si128(_mm_adds_epu8(_mm_and_si128(c, age), _mm_add_epi8(older, older)), age);
+		_mm_storeu_si128((__m128i*) (out + i), _mm_or_si128(aged, alive));
+	}
+	fredkin_scalar(up, mid, down, out, i, n);
+}
+
+// ----
+// avx2
+// ----
+
+__attribute__((target("avx2")))
+void moore_avx2(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m256i one = _mm256_set1_epi8(1);
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		__m256i s = _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (up + i - 1)), one);
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (up + i)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (up + i + 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (mid + i - 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (mid + i + 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (down + i - 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (down + i)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (down + i + 1)), one));
+		_mm256_storeu_si256((__m256i*) (out + i), s);
+	}
+	moore_scalar(up, mid, down, out, i, n);
+}
+
+__attribute__((target("avx2")))
+void von_neumann_avx2(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m256i one = _mm256_set1_epi8(1);
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		__m256i s = _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (up + i)), one);
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (mid + i - 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (mid + i + 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (down + i)), one));
+		_mm256_storeu_si256((__m256i*) (out + i), s);
+	}
+	von_neumann_scalar(up, mid, down, out, i, n);
+}
+
+__attribute__((target("avx2")))
+void fredkin_avx2(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m256i one = _mm256_set1_epi8(1);
+	const __m256i age = _mm256_set1_epi8((char) 0xfe);
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		__m256i s = _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (up + i)), one);
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (mid + i - 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (mid + i + 1)), one));
+		s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (down + i)), one));
+		const __m256i alive = _mm256_and_si256(s, one);
+
+		// the saturating add stops the age at 127
+		const __m256i c = _mm256_loadu_si256((const __m256i*) (mid + i));
+		const __m256i older = _mm256_and_si256(c, alive);
+		const __m256i aged = _mm256_and_si256(_mm256_adds_epu8(_mm256_and_si256(c, age), _mm256_add_epi8(older, older)), age);
+		_mm256_storeu_si256((__m256i*) (out + i), _mm256_or_si256(aged, alive));
+	}
+	fredkin_scalar(up, mid, down, out, i, n);
+}
+
+// -------
+// avx-512
+// -------
+
+__attribute__((target("avx512f,avx512bw")))
+void moore_avx512(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m512i one = _mm512_set1_epi8(1);
+	int i = 0;
+	for (; i + 64 <= n; i += 64) {
+		__m512i s = _mm512_and_si512(_mm512_loadu_si512(up + i - 1), one);
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(up + i), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(up + i + 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(mid + i - 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(mid + i + 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(down + i - 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(down + i), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(down + i + 1), one));
+		_mm512_storeu_si512(out + i, s);
+	}
+	moore_scalar(up, mid, down, out, i, n);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void von_neumann_avx512(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m512i one = _mm512_set1_epi8(1);
+	int i = 0;
+	for (; i + 64 <= n; i += 64) {
+		__m512i s = _mm512_and_si512(_mm512_loadu_si512(up + i), one);
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(mid + i - 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(mid + i + 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(down + i), one));
+		_mm512_storeu_si512(out + i, s);
+	}
+	von_neumann_scalar(up, mid, down, out, i, n);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void fredkin_avx512(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	const __m512i one = _mm512_set1_epi8(1);
+	const __m512i age = _mm512_set1_epi8((char) 0xfe);
+	int i = 0;
+	for (; i + 64 <= n; i += 64) {
+		__m512i s = _mm512_and_si512(_mm512_loadu_si512(up + i), one);
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(mid + i - 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(mid + i + 1), one));
+		s = _mm512_add_epi8(s, _mm512_and_si512(_mm512_loadu_si512(down + i), one));
+		const __m512i alive = _mm512_and_si512(s, one);
+
+		// the saturating add stops the age at 127
+		const __m512i c = _mm512_loadu_si512(mid + i);
+		const __m512i older = _mm512_and_si512(c, alive);
+		const __m512i aged = _mm512_and_si512(_mm512_adds_epu8(_mm512_and_si512(c, age), _mm512_add_epi8(older, older)), age);
+		_mm512_storeu_si512(out + i, _mm512_or_si512(aged, alive));
+	}
+	fredkin_scalar(up, mid, down, out, i, n);
+}
+
+#endif
+
+// --------
+// dispatch
+// --------
+
+typedef void (*row_kernel)(const unsigned char*, const unsigned char*, const unsigned char*, unsigned char*, int);
+
+struct Kernels {
+	CountKernel kind;			//the instruction set of this entry
+	row_kernel moore;			//8 neighbor kernel
+	row_kernel von_neumann;		//4 neighbor kernel
+	row_kernel fredkin;			//packed Fredkin generation
+};
+
+const Kernels table[] = {
+	{SCALAR_KERNEL, moore0_scalar, von_neumann0_scalar, fredkin0_scalar},
+#ifdef LIFE_X86
+	{SSE2_KERNEL, moore_sse2, von_neumann_sse2, fredkin_sse2},
+	{AVX2_KERNEL, moore_avx2, von_neumann_avx2, fredkin_avx2},
+	{AVX512_KERNEL, moore_avx512, von_neumann_avx512, fredkin_avx512},
+#endif
+};
+
+bool supported(CountKernel k) {
+#ifdef LIFE_X86
+	switch (k) {
+	case SCALAR_KERNEL:
+		return true;
+	case SSE2_KERNEL:
+		return __builtin_cpu_supports("sse2");
+	case AVX2_KERNEL:
+		return __builtin_cpu_supports("avx2");
+	case AVX512_KERNEL:
+		return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+	}
+	return false;
+#else
+	return k == SCALAR_KERNEL;
+#endif
+}
+
+CountKernel detect() {
+#ifdef LIFE_X86
+	__builtin_cpu_init();
+#endif
+	CountKernel best = SCALAR_KERNEL;
+	for (const Kernels& k : table)
+		if (supported(k.kind))
+			best = k.kind;
+	return best;
+}
+
+/**
+ * the kernels in use, picked the first time any kernel runs
+ */
+const Kernels*& active() {
+	static const Kernels* k = &table[detect()];
+	return k;
+}
+
+}
+
+void moore_counts(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	active()->moore(up, mid, down, out, n);
+}
+
+void von_neumann_counts(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	active()->von_neumann(up, mid, down, out, n);
+}
+
+void fredkin_step(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+	active()->fredkin(up, mid, down, out, n);
+}
+
+CountKernel best_kernel() {
+	static const CountKernel best = detect();
+	return best;
+}
+
+CountKernel active_kernel() {
+	return active()->kind;
+}
+
+bool use_kernel(CountKernel k) {
+	if (k > best_kernel() || !supported(k))
+		return false;
+	active() = &table[k];
+	return true;
+}
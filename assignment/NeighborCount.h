@@ -0,0 +1,66 @@
+#ifndef NeighborCount_h
+#define NeighborCount_h
+
+// 	-------------------------------------------------------------------------
+//	Row kernels counting live neighbors over a padded plane of one byte per
+//	cell. Bit 0 of each byte is the alive flag, the other bits are ignored.
+//	Every row pointer points at column 0, so column -1 and column n have to
+//	be readable (the border ring of the plane).
+// 	-------------------------------------------------------------------------
+
+/**
+ * the instruction sets the kernels are written for, from slowest to fastest
+ */
+enum CountKernel { SCALAR_KERNEL, SSE2_KERNEL, AVX2_KERNEL, AVX512_KERNEL };
+
+/**
+ * count the 8 neighbors (Conway) of every cell in a row
+ * @param up the row above
+ * @param mid the row being counted
+ * @param down the row below
+ * @param out where the n counts are written
+ * @param n the number of cells in the row
+ */
+void moore_counts(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n);
+
+/**
+ * count the 4 orthogonal neighbors (Fredkin) of every cell in a row
+ * @param up the row above
+ * @param mid the row being counted
+ * @param down the row below
+ * @param out where the n counts are written
+ * @param n the number of cells in the row
+ */
+void von_neumann_counts(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n);
+
+/**
+ * evolve a row of packed Fredkin cells one generation, FredkinLife's cells
+ * bit 0 of each byte is the alive flag and bits 1 to 7 the age, which stops at 127
+ * @param up the row above
+ * @param mid the row being evolved
+ * @param down the row below
+ * @param out where the n evolved cells are written
+ * @param n the number of cells in the row
+ */
+void fredkin_step(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n);
+
+/**
+ * the fastest kernel this cpu supports, detected once with cpuid
+ * @return the best supported kernel
+ */
+CountKernel best_kernel();
+
+/**
+ * the kernel moore_counts and von_neumann_counts currently run
+ * @return the active kernel
+ */
+CountKernel active_kernel();
+
+/**
+ * choose the kernel to run, not thread safe, call it before evolving
+ * @param k the kernel to use, ignored if the cpu does not support it
+ * @return true if k is now the active kernel
+ */
+bool use_kernel(CountKernel k);
+
+#endif
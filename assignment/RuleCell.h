@@ -0,0 +1,177 @@
+#ifndef RuleCell_h
+#define RuleCell_h
+
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+
+#include "Life.h"
+
+// 	-----------------------------------------------------------------
+//	Moore and VonNeumann are the neighborhoods a RuleCell counts over
+// 	-----------------------------------------------------------------
+struct Moore {};		//the 8 surrounding cells
+struct VonNeumann {};	//the 4 orthogonal cells
+
+/**
+ * the bitmask of a list of neighbor counts, rule_mask("23") has bits 2 and 3 set
+ * @param counts the digits of the counts
+ * @return the bitmask, usable as a template argument
+ */
+constexpr unsigned rule_mask(const char* counts) {
+	return *counts ? (1u << (*counts - '0')) | rule_mask(counts + 1) : 0;
+}
+
+// 	--------------------------------------------------------------------------
+//	Class template RuleCell is a cell of any outer totalistic rule. A dead cell
+//	is born when bit n of Birth is set, a live one survives when bit n of
+//	Survive is set, n being its live neighbors in neighborhood N. The rule is
+//	resolved at compile time, there is no virtual call and nothing to interpret.
+// 	--------------------------------------------------------------------------
+template <unsigned Birth, unsigned Survive, class N = Moore>
+class RuleCell {
+	/**
+	 * evolve this cell, the operator is to be called on the cell and it's neighbors
+	 * @param old_cell the cell to evolve
+	 * @param neighbors the neighbors, in the order up, right, down, left, up-right, down-right, down-left, up-left
+	 * @return a new cell that's evolved from old_cell and neighbors
+	 */
+	friend RuleCell operator+(const RuleCell& old_cell, const Neighborhood<RuleCell>& neighbors) {
+		const int n = std::is_same<N, VonNeumann>::value ? 4 : 8;
+		int live_neighbors = 0;
+		for (int i = 0; i < n; i++)
+			live_neighbors += neighbors[i].is_alive();
+
+		return old_cell + live_neighbors;
+	}
+
+	/**
+	 * evolve this cell from the number of its live neighbors
+	 * @param old_cell the cell to evolve
+	 * @param live_neighbors how many cells of the neighborhood are alive
+	 * @return a new cell that's evolved from old_cell
+	 */
+	friend RuleCell operator+(const RuleCell& old_cell, int live_neighbors) {
+		return RuleCell(next(old_cell.alive, live_neighbors), false);
+	}
+
+	/**
+	 * are the two cells in the same state?
+	 * @param lhs the left hand side cell
+	 * @param rhs the right hand side cell
+	 * @return true if both are borders or both are alive or both are dead
+	 */
+	friend bool operator==(const RuleCell& lhs, const RuleCell& rhs) {
+		return lhs.border == rhs.border && lhs.alive == rhs.alive;
+	}
+
+	/**
+	 * print a cell's symbol
+	 * @param out the ostream to write to
+	 * @param c the cell we want to print
+	 * @return the ostream
+	 */
+	friend std::ostream& operator<<(std::ostream& out, const RuleCell& c) {
+		return out << c.symbol();
+	}
+
+public:
+	typedef N neighborhood;
+
+	/**
+	 * the rule itself, bit n of the mask of the current state
+	 * @param alive_ is the cell alive now?
+	 * @param live_neighbors how many cells of the neighborhood are alive
+	 * @return true if the cell is alive next generation
+	 */
+	static constexpr bool next(bool alive_, int live_neighbors) {
+		return (((alive_ ? Survive : Birth) >> live_neighbors) & 1) != 0;
+	}
+
+	/**
+	 * constructor
+	 * @param border_ the value if the cell is a border or not
+	 */
+	RuleCell(bool border_ = false) : alive(false), border(border_) {}
+
+	/**
+	 * constructor
+	 * @param input the character representation of a cell, * or .
+	 */
+	RuleCell(const char& input) : alive(input == '*'), border(false) {
+		assert(input == '*' || input == '.');
+	}
+
+	/**
+	 * is the cell alive or dead?
+	 * @return true if alive, false if dead
+	 */
+	bool is_alive() const { return alive; }
+
+	/**
+	 * is the cell a border?
+	 * @return true if border, false if not a border
+	 */
+	bool is_border() const { return border; }
+
+	/**
+	 * this cell's symbol, the character operator<< writes
+	 * @return the symbol of the cell
+	 */
+	char symbol() const { return alive ? '*' : '.'; }
+
+private:
+	/**
+	 * constructor
+	 * @param alive_ the boolean to determine is the cell is alive or not
+	 * @param border_ the value if the cell is a border or not
+	 */
+	RuleCell(bool alive_, bool border_) : alive(alive_), border(border_) {}
+
+	bool alive;		//boolean that holds the state of the cell, never set for a border
+	bool border;	//boolean that tells if the cell is a border or not
+};
+
+/**
+ * the rules we run, in the usual B/S notation
+ */
+typedef RuleCell<rule_mask("3"), rule_mask("23")> ConwayRule;							// B3/S23
+typedef RuleCell<rule_mask("36"), rule_mask("23")> HighLifeRule;						// B36/S23
+typedef RuleCell<rule_mask("3678"), rule_mask("34678")> DayAndNightRule;				// B3678/S34678
+typedef RuleCell<rule_mask("2"), rule_mask("")> SeedsRule;								// B2/S
+typedef RuleCell<rule_mask("13"), rule_mask("13"), VonNeumann> FredkinRule;			// B13/S13, without the ages
+
+// 	-----------------------------------------------------------------------
+//	RuleCells count their neighbors with the row kernels of their
+//	neighborhood and are stored 1 bit per cell in checkpoints
+// 	-----------------------------------------------------------------------
+template <unsigned Birth, unsigned Survive>
+struct NeighborKernel<RuleCell<Birth, Survive, Moore> > {
+	static const bool dense = true;
+
+	static void count(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+		moore_counts(up, mid, down, out, n);
+	}
+};
+
+template <unsigned Birth, unsigned Survive>
+struct NeighborKernel<RuleCell<Birth, Survive, VonNeumann> > {
+	static const bool dense = true;
+
+	static void count(const unsigned char* up, const unsigned char* mid, const unsigned char* down, unsigned char* out, int n) {
+		von_neumann_counts(up, mid, down, out, n);
+	}
+};
+
+template <unsigned Birth, unsigned Survive, class N>
+struct CellCodec<RuleCell<Birth, Survive, N> > {
+	static const unsigned char kind = 5;
+	static const int bits = 1;
+	// the rule, so a board of one rule is never restored as another
+	static const std::uint32_t variant = Birth | Survive << 9 | (std::is_same<N, VonNeumann>::value ? 1u << 18 : 0);
+
+	static std::uint32_t encode(const RuleCell<Birth, Survive, N>& c) { return c.is_alive(); }
+	static RuleCell<Birth, Survive, N> decode(std::uint32_t v) { return RuleCell<Birth, Survive, N>(v ? '*' : '.'); }
+};
+
+#endif
@@ -0,0 +1,55 @@
+// -----------------------------
+// projects/life/RunDistLife.c++
+// -----------------------------
+
+// --------
+// includes
+// --------
+
+#include <cstdlib>   // atoi
+#include <iostream>  // cout, cerr
+
+#include <mpi.h>
+
+#include "Comm.h"
+#include "DistLife.h"
+#include "MappedFile.h"
+
+// ----
+// main
+// ----
+
+/**
+ * mpirun -n <ranks> RunDistLife <board> <height> <width> <generations> [<every>]
+ * evolve a board in the format of Life<ConwayCell> across every rank, rank 0 prints every <every> generations
+ */
+int main (int argc, char* argv[]) {
+    using namespace std;
+
+    MPI_Init(&argc, &argv);
+    if (argc < 5) {
+        cerr << "usage: RunDistLife <board> <height> <width> <generations> [<every>]" << endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    const int h           = atoi(argv[2]);
+    const int w           = atoi(argv[3]);
+    const int generations = atoi(argv[4]);
+    const int every       = argc > 5 ? atoi(argv[5]) : 1;
+
+    {
+        // every rank maps the file and decodes its own block
+        const MappedFile board(argv[1]);
+        MPIComm comm;
+        DistLife<ConwayCell, MPIComm> l(comm, board.data(), board.size(), h, w);
+        l.print(cout);
+        for (int i = 1; i <= generations; i++) {
+            l.evolve_all();
+            if (i % every == 0)
+                l.print(cout);
+        }
+    }
+
+    MPI_Finalize();
+    return 0;
+}
@@ -74,11 +74,16 @@ int main () {
     {
         Life<ConwayCell> l3(cin, 109, 69);
         l3.print(cout);
-        for (int i = 1; i <= 2500; i++) {
+        for (int i = 1; i < 10; i++) {
             l3.evolve_all();
-            if (i < 10 || i == 283 || i == 323 || i == 2500)
-                l3.print(cout);
+            l3.print(cout);
         }
+        l3.evolve_n(283 - 9);
+        l3.print(cout);
+        l3.evolve_n(40);
+        l3.print(cout);
+        l3.evolve_n(2177);
+        l3.print(cout);
     }
 
     // -----------------------
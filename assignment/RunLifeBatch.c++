@@ -0,0 +1,38 @@
+// ------------------------------
+// projects/life/RunLifeBatch.c++
+// ------------------------------
+
+// --------
+// includes
+// --------
+
+#include <cstdlib>   // atoi
+#include <iostream>  // cin, cout, cerr
+#include <stdexcept> // runtime_error
+#include <thread>    // hardware_concurrency
+
+#include "LifeBatch.h"
+
+// ----
+// main
+// ----
+
+/**
+ * RunLifeBatch [<threads>] < RunLifeBatch.in
+ * every board of cin, on all cores unless told otherwise, written in input order
+ */
+int main (int argc, char* argv[]) {
+    using namespace std;
+
+    const int threads = argc > 1 ? atoi(argv[1]) : (int) thread::hardware_concurrency();
+
+    try {
+        LifeBatch batch(cin);
+        batch.run(cout, threads);
+    }
+    catch (const runtime_error& e) {
+        cerr << "RunLifeBatch: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
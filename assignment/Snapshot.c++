@@ -0,0 +1,34 @@
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "Snapshot.h"
+
+using namespace std;
+
+// ----------------
+// SnapshotSchedule
+// ----------------
+
+SnapshotSchedule SnapshotSchedule::every(int k, int last, int first) {
+	assert(k > 0);
+	vector<int> prints;
+	for (int g = first; g <= last; g += k)
+		prints.push_back(g);
+	return SnapshotSchedule(prints);
+}
+
+SnapshotSchedule SnapshotSchedule::at(vector<int> generations) {
+	sort(generations.begin(), generations.end());
+	generations.erase(unique(generations.begin(), generations.end()), generations.end());
+	return SnapshotSchedule(generations);
+}
+
+int SnapshotSchedule::next(int g) const {
+	vector<int>::const_iterator it = lower_bound(prints.begin(), prints.end(), g);
+	return it == prints.end() ? -1 : *it;
+}
+
+bool SnapshotSchedule::contains(int g) const {
+	return binary_search(prints.begin(), prints.end(), g);
+}
@@ -0,0 +1,219 @@
+#ifndef Snapshot_h
+#define Snapshot_h
+
+#include <vector>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cassert>
+
+#include "Life.h"
+
+// 	-------------------------------------------------------------------------
+//	Class SnapshotSchedule is the generations of a run that get printed, in
+//	increasing order, such as every 4th up to 28 or exactly 283, 323 and 2500
+// 	-------------------------------------------------------------------------
+class SnapshotSchedule {
+public:
+
+	/**
+	 * every k-th generation, first, first + k, first + 2k, ... up to last
+	 * @param k the distance between two printed generations, at least 1
+	 * @param last the last generation that can be printed
+	 * @param first the first generation printed
+	 */
+	static SnapshotSchedule every(int k, int last, int first = 0);
+
+	/**
+	 * exactly the generations given, in any order, repeats are printed once
+	 * @param generations the generations to print
+	 */
+	static SnapshotSchedule at(std::vector<int> generations);
+
+	/**
+	 * the first generation printed at or after g
+	 * @param g a generation
+	 * @return the generation, or -1 if none is left
+	 */
+	int next(int g) const;
+
+	/**
+	 * is generation g printed?
+	 * @param g a generation
+	 * @return true if it is
+	 */
+	bool contains(int g) const;
+
+	/**
+	 * every generation printed, in increasing order
+	 */
+	const std::vector<int>& generations() const { return prints; }
+
+private:
+	explicit SnapshotSchedule(std::vector<int> p) : prints(p) {}
+
+	std::vector<int> prints;	//the generations to print, in increasing order
+};
+
+// 	-------------------------------------------------------------------------
+//	Class SnapshotWriter prints the generations of a board on its own thread,
+//	so the board can keep evolving while a generation is being formatted and
+//	written. push() copies the board into one of depth snapshots and queues
+//	it; when all of them are queued or being written, push() waits for one to
+//	be written, so a slow stream holds the board back instead of letting the
+//	queue grow. The snapshots are reused, so after the first depth pushes no
+//	memory is allocated. The stream must not be used by anyone else until
+//	flush() returns or the writer is destroyed.
+// 	-------------------------------------------------------------------------
+template <class T>
+class SnapshotWriter {
+public:
+
+	/**
+	 * constructor, starts the writer thread
+	 * @param o the ostream the generations are printed to
+	 * @param depth how many generations can be pushed ahead of the writer, at least 1
+	 */
+	explicit SnapshotWriter(std::ostream& o, int depth = 4) :
+			out(o),
+			buffers(depth),
+			busy(false),
+			stop(false),
+			stalls(0),
+			written_(0) {
+		assert(depth > 0);
+		for (int i = 0; i < depth; i++)
+			idle.push_back(i);
+		writer = std::thread(&SnapshotWriter::write, this);
+	}
+
+	/**
+	 * destructor, writes whatever is queued and joins the writer thread
+	 */
+	~SnapshotWriter() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stop = true;
+		}
+		queued_cond.notify_one();
+		writer.join();
+	}
+
+	/**
+	 * queue the current generation of a board, waits while every snapshot is in use
+	 * @param life the board, it can be evolved again as soon as push returns
+	 */
+	template <class Stats, class Boundary, class Probe>
+	void push(const Life<T, Stats, Boundary, Probe>& life) {
+		int i;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			if (idle.empty())
+				stalls++;
+			idle_cond.wait(guard, [this] { return !idle.empty(); });
+			i = idle.front();
+			idle.pop_front();
+		}
+
+		life.snapshot(buffers[i]);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			queued.push_back(i);
+		}
+		queued_cond.notify_one();
+	}
+
+	/**
+	 * evolve a board through a schedule, pushing every generation of it
+	 * generations of the schedule before the one of the board are skipped
+	 * @param life the board
+	 * @param schedule the generations to print
+	 */
+	template <class Stats, class Boundary, class Probe>
+	void run(Life<T, Stats, Boundary, Probe>& life, const SnapshotSchedule& schedule) {
+		for (int g = schedule.next(life.generation()); g != -1; g = schedule.next(g + 1)) {
+			const int gap = g - life.generation();
+			if (gap == 1)
+				life.evolve_all();
+			else if (gap > 1)
+				life.evolve_n(gap);
+			push(life);
+		}
+	}
+
+	/**
+	 * wait until everything pushed is written and the stream is flushed
+	 */
+	void flush() {
+		std::unique_lock<std::mutex> guard(lock);
+		idle_cond.wait(guard, [this] { return queued.empty() && !busy; });
+		out.flush();
+	}
+
+	/**
+	 * how many generations were written?
+	 * @return the number of generations
+	 */
+	int written() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return written_;
+	}
+
+	/**
+	 * how many times did push() have to wait for the writer?
+	 * @return the number of waits
+	 */
+	int waits() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return stalls;
+	}
+
+	SnapshotWriter(const SnapshotWriter&) = delete;
+	SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+private:
+	/**
+	 * the loop of the writer thread, prints the queued snapshots in order until stopped
+	 */
+	void write() {
+		std::unique_lock<std::mutex> guard(lock);
+		while (true) {
+			queued_cond.wait(guard, [this] { return stop || !queued.empty(); });
+			if (queued.empty())
+				return;
+
+			const int i = queued.front();
+			queued.pop_front();
+			busy = true;
+
+			guard.unlock();
+			buffers[i].print(out);
+			guard.lock();
+
+			busy = false;
+			written_++;
+			idle.push_back(i);
+			idle_cond.notify_all();
+		}
+	}
+
+	std::ostream& out;						//the stream the generations are printed to
+	std::vector<Snapshot<T>> buffers;		//the snapshots, reused
+
+	mutable std::mutex lock;				//guards everything below
+	std::condition_variable idle_cond;		//signaled when a snapshot is written
+	std::condition_variable queued_cond;	//signaled when a snapshot is queued or on stop
+	std::deque<int> idle;					//the snapshots free to be pushed into
+	std::deque<int> queued;					//the snapshots waiting to be written, in order
+	bool busy;								//the writer is printing a snapshot
+	bool stop;								//set by the destructor
+	int stalls;								//pushes that had to wait
+	int written_;							//snapshots written
+
+	std::thread writer;						//started last, once everything above is set up
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef StreamLife_h
+#define StreamLife_h
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "Life.h"
+
+// 	--------------------------------------------------------------------------
+//	Generic Class StreamLife evolves a board k generations in one pass over
+//	its text, without ever holding the board: the rows are read one at a time
+//	and each row of generation k is written as soon as it is known. Every
+//	generation from 0 to k has a window of the 3 rows around the row being
+//	evolved, row r of generation j + 1 is evolved as soon as row r + 1 of
+//	generation j is, so the rows of generation k come out k rows behind the
+//	rows read. The memory is 3k + 3 rows of width cells and one dead row all
+//	the windows share, above and below the board, whatever the height.
+//	Like Life<T>, the cells outside the board are dead forever.
+// 	--------------------------------------------------------------------------
+template <class T>
+class StreamLife {
+public:
+
+	/**
+	 * constructor
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 * @param k the generations evolved in one pass
+	 */
+	StreamLife(int h, int w, int k = 1) :
+			height(h),
+			width(w),
+			generations(k),
+			stride(w + 2),
+			population_(0),
+			cells((3 * (k + 1) + 1) * stride, T(true)),
+			alive(NeighborKernel<T>::dense ? cells.size() : 0, 0),
+			counts(w + 2) {
+		assert(h >= 0 && w >= 0 && k >= 0);
+	}
+
+	/**
+	 * read a board, evolve it generations generations and write it
+	 * every row written is the same as Life<T>::print writes for that generation, with the blank
+	 * line after the last, but the header is not written: it has the population, which is only
+	 * known once every row is, see population()
+	 * @param in the istream to read from, the same text Life<T> reads
+	 * @param out the ostream the rows are written to, one at a time, as each is known
+	 * @return the population of the board written
+	 */
+	int run(std::istream& in, std::ostream& out) {
+		std::string line(width + 1, '\n');
+		population_ = 0;
+
+		// row s of the text is read, then row s - j of generation j is evolved, for every j
+		for (int s = 0; s < height + generations; s++) {
+			if (s < height)
+				read(in, s, line);
+
+			for (int j = 1; j <= generations; j++) {
+				const int x = s - j;
+				if (x >= 0 && x < height)
+					evolve_row(dense(), j, x);
+			}
+
+			const int x = s - generations;
+			if (x >= 0)
+				write(out, x, line);
+		}
+
+		// the blank line that ends the board
+		if (in.peek() == '\n')
+			in.get();
+
+		out.put('\n');
+		return population_;
+	}
+
+	/**
+	 * how many cells are alive in the board written by run()?
+	 * @return the population
+	 */
+	int population() const { return population_; }
+
+	/**
+	 * what generation does run() write?
+	 * @return the generation
+	 */
+	int generation() const { return generations; }
+
+	/**
+	 * how many cells are held, whatever the height of the board?
+	 * @return the number of cells
+	 */
+	std::size_t window_cells() const { return cells.size(); }
+
+private:
+	typedef std::integral_constant<bool, NeighborKernel<T>::dense> dense;
+
+	/**
+	 * where row x of the window of generation j starts, rows off the board are the dead row after every window
+	 */
+	std::ptrdiff_t at(int j, int x) const {
+		return (std::ptrdiff_t) (x < 0 || x >= height ? 3 * (generations + 1) : 3 * j + x % 3) * stride + 1;
+	}
+
+	/**
+	 * read row x of the text into the window of generation 0
+	 */
+	void read(std::istream& in, int x, std::string& line) {
+		in.read(&line[0], line.size());
+		assert(in.gcount() == (std::streamsize) line.size() && line[width] == '\n');
+
+		const std::ptrdiff_t i = at(0, x);
+		for (int y = 0; y < width; y++) {
+			const unsigned char glyph = line[y];
+			assert(glyph != '\n');
+
+			cells[i + y] = T((char) glyph);
+			if (dense::value)
+				alive[i + y] = cells[i + y].is_alive();
+		}
+	}
+
+	/**
+	 * write row x of the window of the last generation
+	 */
+	void write(std::ostream& out, int x, std::string& line) {
+		const T* row = &cells[at(generations, x)];
+		for (int y = 0; y < width; y++) {
+			line[y] = row[y].symbol();
+			population_ += row[y].is_alive();
+		}
+		line[width] = '\n';
+		out.write(line.data(), line.size());
+	}
+
+	/**
+	 * evolve row x of the window of generation j - 1 into the one of generation j, each cell is given a view of its 8 neighbors
+	 * the 3 rows around x are not next to each other, so the offsets are of these rows
+	 */
+	void evolve_row(std::false_type, int j, int x) {
+		const std::ptrdiff_t i = at(j - 1, x);
+		const std::ptrdiff_t up = at(j - 1, x - 1) - i;
+		const std::ptrdiff_t down = at(j - 1, x + 1) - i;
+		const std::ptrdiff_t offsets[8] = {-1, down, 1, up, down - 1, down + 1, up + 1, up - 1};
+
+		T* next = &cells[at(j, x)];
+		for (int y = 0; y < width; y++) {
+			const Neighborhood<T> neighbors(&cells[i + y], offsets);
+			next[y] = cells[i + y] + neighbors;
+		}
+	}
+
+	/**
+	 * evolve row x of the window of generation j - 1 into the one of generation j, each cell is given its live neighbor count
+	 */
+	void evolve_row(std::true_type, int j, int x) {
+		const std::ptrdiff_t i = at(j - 1, x);
+		NeighborKernel<T>::count(&alive[at(j - 1, x - 1)], &alive[i], &alive[at(j - 1, x + 1)], &counts[0], width);
+
+		const std::ptrdiff_t n = at(j, x);
+		for (int y = 0; y < width; y++) {
+			T new_cell = cells[i + y] + (int) counts[y];
+			alive[n + y] = new_cell.is_alive();
+			cells[n + y] = std::move(new_cell);
+		}
+	}
+
+	int height;			//height of the board
+	int width;			//width of the board
+	int generations;	//the generations evolved in one pass
+	int stride;			//cells in a row of a window, the width and the border on each side
+	int population_;	//population of the board written
+
+	std::vector<T> cells;				//3 rows of width + 2 cells for every generation, 0 to generations, then the dead row
+	std::vector<unsigned char> alive;	//the same rows, 1 for alive, dense cells only
+	std::vector<unsigned char> counts;	//scratch space for the counts of one row
+};
+
+#endif
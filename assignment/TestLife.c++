@@ -1,12 +1,51 @@
 #include <sstream>
+#include <algorithm>
 #include <vector>
+#include <cstdlib>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
 
 #include "gtest/gtest.h"
 
 #include "Life.h"
+#include "BitLife.h"
+#include "Comm.h"
+#include "DeviceLife.h"
+#include "DistLife.h"
+#include "FredkinLife.h"
+#include "HashLife.h"
+#include "LifeBatch.h"
+#include "LifeCache.h"
+#include "LifeProbe.h"
+#include "LutLife.h"
+#include "MappedFile.h"
+#include "NeighborCount.h"
+#include "RuleCell.h"
+#include "Snapshot.h"
+#include "StreamLife.h"
+#include "ThreadPool.h"
+#include "TiledLife.h"
 
 using namespace std;
 
+string random_board(int h, int w, unsigned seed, const string& glyphs) {
+	// deterministic board text for comparing engines, one glyph in four is the first one
+	string s;
+	for (int x = 0; x < h; x++) {
+		for (int y = 0; y < w; y++) {
+			seed = seed * 1103515245 + 12345;
+			if ((seed >> 16) % 4 == 0)
+				s += glyphs[0];
+			else
+				s += glyphs[1 + (seed >> 20) % (glyphs.size() - 1)];
+		}
+		s += '\n';
+	}
+	return s + '\n';
+}
+
 TEST(ConwayFixture, conway_construct1) {
 	ConwayCell c = ConwayCell('*');
 	ASSERT_EQ(c.is_alive(), true);
@@ -64,6 +103,34 @@ TEST(ConwayFixture, conway_clone2) {
 	delete c2;
 }
 
+TEST(ConwayFixture, conway_neighborhood1) {
+	// the board is stored row after row, up and down are the cells before and after in a row
+	const ConwayCell board[9] = {'.', '*', '.',
+	                             '*', '.', '.',
+	                             '.', '.', '*'};
+	std::ptrdiff_t offsets[8];
+	Neighborhood<ConwayCell>::board_offsets(3, offsets);
+	const Neighborhood<ConwayCell> neighbors(&board[4], offsets);
+
+	ASSERT_EQ(&neighbors[0], &board[3]);
+	ASSERT_EQ(&neighbors[1], &board[7]);
+	ASSERT_EQ(&neighbors[5], &board[8]);
+	ASSERT_EQ(&neighbors[7], &board[0]);
+	ASSERT_TRUE((ConwayCell('.') + neighbors).is_alive());
+}
+
+TEST(ConwayFixture, conway_neighborhood2) {
+	const Cell board[9] = {Cell('.'), Cell('*'), Cell('.'),
+	                       Cell('*'), Cell('-'), Cell('.'),
+	                       Cell('.'), Cell('*'), Cell('.')};
+	std::ptrdiff_t offsets[8];
+	Neighborhood<Cell>::board_offsets(3, offsets);
+	const Neighborhood<Cell> neighbors(&board[4], offsets);
+
+	// a FredkinCell only counts the 4 orthogonal neighbors, 3 of them are alive
+	ASSERT_TRUE((board[4] + neighbors).is_alive());
+	ASSERT_EQ((board[4] + neighbors).symbol(), '0');
+}
 
 class ConwayEvolutionFixture : public ::testing::TestWithParam<vector<char>> {
 	// Fixture for running tests of evolution. The argument is a vector containing the neighbors, then the value of the cell, then the expected value
@@ -347,7 +414,7 @@ TEST(CellFixture, cell_conway_copy_assignment1) {
 	Cell c = Cell(&cc);
 	ASSERT_EQ(c.acell->is_alive(), true);
 
-	Cell c2 = Cell(&cc2);
+	Cell c2 = Cell(cc2);
 	ASSERT_EQ(c2.acell->is_alive(), false);
 
 	c2 = c;
@@ -365,7 +432,7 @@ TEST(CellFixture, cell_conway_copy_assignment2) {
 	Cell c = Cell(&cc);
 	ASSERT_EQ(c.acell->is_alive(), false);
 
-	Cell c2 = Cell(&cc2);
+	Cell c2 = Cell(cc2);
 	ASSERT_EQ(c2.acell->is_alive(), true);
 
 	c2 = c;
@@ -374,6 +441,39 @@ TEST(CellFixture, cell_conway_copy_assignment2) {
 }
 
 
+TEST(CellFixture, cell_inline1) {
+	// ConwayCells and FredkinCells live inside the Cell, copies do not allocate
+	Cell c = Cell('*');
+	Cell f = Cell('5');
+	Cell c2 = c;
+	Cell f2(FredkinCell(3, true));
+
+	for (Cell* p : {&c, &f, &c2, &f2}) {
+		const char* begin = reinterpret_cast<const char*>(p);
+		const char* a = reinterpret_cast<const char*>(p->acell);
+		ASSERT_TRUE(a >= begin && a < begin + sizeof(Cell));
+	}
+
+	c2 = f;
+	ASSERT_EQ(dynamic_cast<FredkinCell*>(c2.acell)->age(), 5);
+	c2 = c2;
+	ASSERT_EQ(dynamic_cast<FredkinCell*>(c2.acell)->age(), 5);
+}
+
+TEST(CellFixture, cell_copy_assignment_heap1) {
+	// a cell handed over by pointer is owned, and released by the next assignment
+	Cell c = Cell(new FredkinCell('7'));
+	ASSERT_EQ(c.is_alive(), true);
+
+	c = Cell('.');
+	ASSERT_EQ(c.is_alive(), false);
+
+	Cell c2 = Cell(new ConwayCell('*'));
+	c = c2;
+	ASSERT_EQ(c.is_alive(), true);
+	ASSERT_NE(c.acell, c2.acell);
+}
+
 class CellEvolutionFixture : public ::testing::TestWithParam<vector<char>> {
 	// Fixture for running tests of evolution. The argument is a vector containing the neighbors, then the value of the cell, then the expected value
 
@@ -451,6 +551,103 @@ INSTANTIATE_TEST_CASE_P(CellEvolution, CellEvolutionFixture, ::testing::Values(
 
 	));
 
+// ----------------
+// MixedCellFixture
+// ----------------
+
+TEST(MixedCellFixture, mixed_construct1) {
+	MixedCell c = MixedCell('*');
+	ASSERT_EQ(c.is_alive(), true); ASSERT_EQ(c.is_border(), false); ASSERT_EQ(c.kind(), MixedCell::CONWAY);
+
+	MixedCell f = MixedCell('7');
+	ASSERT_EQ(f.is_alive(), true); ASSERT_EQ(f.kind(), MixedCell::FREDKIN); ASSERT_EQ(f.age(), 7);
+
+	MixedCell d = MixedCell('-');
+	ASSERT_EQ(d.is_alive(), false); ASSERT_EQ(d.kind(), MixedCell::FREDKIN); ASSERT_EQ(d.age(), 0);
+
+	MixedCell b = MixedCell(true);
+	ASSERT_EQ(b.is_alive(), false); ASSERT_EQ(b.is_border(), true);
+
+	ASSERT_EQ(sizeof(MixedCell), 2u);
+}
+
+TEST(MixedCellFixture, mixed_output1) {
+	ostringstream s;
+	s << MixedCell('*') << MixedCell('.') << MixedCell('-') << MixedCell('0') << MixedCell('9') << MixedCell('+');
+	ASSERT_EQ(s.str(), "*.-09+");
+}
+
+TEST_P(CellEvolutionFixture, mixed_evolve) {
+	vector<char> param = GetParam();
+
+	char expected = param.back();
+	param.pop_back();
+	char cell_value = param.back();
+	param.pop_back();
+
+	MixedCell neighbors[8];
+	int i = 0;
+	for (char c : param) {
+		neighbors[i++] = MixedCell(c);
+	}
+
+	MixedCell c = MixedCell(cell_value);
+	MixedCell c2 = c + neighbors;
+
+	ostringstream s;
+	s << c2;
+	ASSERT_EQ(s.str()[0], expected);
+}
+
+TEST(MixedCellFixture, mixed_life1) {
+	// Life<MixedCell> prints exactly what Life<Cell> prints
+	const string boards[] = {
+		".*-5\n*.+-\n-.39\n.-*-\n\n",
+		random_board(20, 20, 29, "0-"),
+		random_board(31, 17, 31, "*.-0"),
+		random_board(12, 40, 37, "1.*-"),
+		// the Life<Cell> 20x20 board of RunLife.in
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"---------00---------\n"
+		"--------0000--------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"
+		"--------------------\n"};
+	const int sizes[][2] = {{4, 4}, {20, 20}, {31, 17}, {12, 40}, {20, 20}};
+
+	for (int b = 0; b < 5; b++) {
+		istringstream in1(boards[b]);
+		istringstream in2(boards[b]);
+		Life<Cell> l1(in1, sizes[b][0], sizes[b][1]);
+		Life<MixedCell> l2(in2, sizes[b][0], sizes[b][1]);
+
+		for (int i = 0; i < 25; i++) {
+			ostringstream out1;
+			ostringstream out2;
+			l1.print(out1);
+			l2.print(out2);
+			ASSERT_EQ(out1.str(), out2.str()) << "board " << b << ", generation " << i;
+
+			l1.evolve_all();
+			l2.evolve_all();
+		}
+	}
+}
+
 // --------
 // LifeTest
 // --------
@@ -761,6 +958,102 @@ TEST(LifeFixture, life_evolve_all5) {
 
 
 
+TEST(LifeFixture, life_double_buffer1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	Life<ConwayCell> l(in, 3, 3);
+
+	l.evolve_all();
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 2, Population = 3.\n.*.\n.*.\n.*.\n\n");
+
+	EXPECT_EQ(l.board.size(), l.next_board.size());
+	for (int i = 0; i < l.width + 2; i++) {
+		EXPECT_EQ(l.board[i].is_border(), true);
+		EXPECT_EQ(l.next_board[i].is_border(), true);
+		EXPECT_EQ(l.board[(l.height + 1) * (l.width + 2) + i].is_border(), true);
+		EXPECT_EQ(l.next_board[(l.height + 1) * (l.width + 2) + i].is_border(), true);
+	}
+}
+
+TEST(LifeFixture, life_double_buffer2) {
+	istringstream in(".*-5\n*.+-\n-.39\n.-*-\n\n");
+
+	Life<Cell> l(in, 4, 4);
+
+	l.evolve_all();
+	l.evolve_all();
+
+	for (int x = 0; x < l.height + 2; x++) {
+		EXPECT_EQ(l.board[x * (l.width + 2)].is_border(), true);
+		EXPECT_EQ(l.board[x * (l.width + 2) + l.width + 1].is_border(), true);
+		EXPECT_EQ(l.next_board[x * (l.width + 2)].is_border(), true);
+	}
+
+	EXPECT_EQ(l.next_board[7].is_border(), false);
+}
+
+
+
+TEST(LifeFixture, life_cell_inline1) {
+	istringstream in(".*-5\n*.+-\n-.39\n.-*-\n\n");
+
+	Life<Cell> l(in, 4, 4);
+	l.evolve_all();
+	l.evolve_all();
+
+	for (Life<Cell>::iterator<Cell> it = l.begin(); it != l.end(); ++it) {
+		const char* begin = reinterpret_cast<const char*>(&*it);
+		const char* a = reinterpret_cast<const char*>((*it).acell);
+		ASSERT_TRUE(a >= begin && a < begin + sizeof(Cell));
+	}
+}
+
+TEST(LifeFixture, life_cell_move1) {
+	// a cell on the heap changes hands, nothing is cloned
+	Cell c1(new FredkinCell(7, true));
+	AbstractCell* p = c1.acell;
+
+	Cell c2(std::move(c1));
+	ASSERT_EQ(c2.acell, p);
+	ASSERT_EQ(c1.acell, nullptr);
+
+	Cell c3('*');
+	c3 = std::move(c2);
+	ASSERT_EQ(c3.acell, p);
+	ASSERT_EQ(c2.acell, nullptr);
+	ASSERT_EQ(c3.symbol(), '7');
+
+	c3 = std::move(c3);
+	ASSERT_EQ(c3.acell, p);
+}
+
+TEST(LifeFixture, life_cell_move2) {
+	// an inline cell is copied into the storage of the cell it moves to
+	Cell c1('3');
+	Cell c2(std::move(c1));
+	const char* begin = reinterpret_cast<const char*>(&c2);
+	const char* a = reinterpret_cast<const char*>(c2.acell);
+	ASSERT_TRUE(a >= begin && a < begin + sizeof(Cell));
+	ASSERT_EQ(c2.symbol(), '3');
+
+	c1 = Cell('*');
+	c2 = std::move(c1);
+	ASSERT_EQ(c2.symbol(), '*');
+	ASSERT_TRUE(dynamic_cast<ConwayCell*>(c2.acell) != nullptr);
+
+	// moved into a grown vector, every cell is still inline
+	vector<Cell> cells(3, Cell('-'));
+	cells.reserve(100);
+	for (const Cell& c : cells) {
+		const char* b = reinterpret_cast<const char*>(&c);
+		ASSERT_TRUE(reinterpret_cast<const char*>(c.acell) >= b && reinterpret_cast<const char*>(c.acell) < b + sizeof(Cell));
+	}
+}
+
 TEST(LifeFixture, life_print1) {
 	istringstream in(".*.\n.*.\n.*.\n\n");
 
@@ -819,7 +1112,6 @@ TEST(LifeFixture, life_begin2) {
 
 	Life<Cell>::iterator<Cell> c1 = l.begin();
 	ASSERT_EQ((*c1).acell->is_alive(), true); ASSERT_EQ((*c1).acell->is_border(), false);
-	(*c1).~Cell();
 	*c1 = Cell('.');
 	++c1;
 	--c1;
@@ -1039,3 +1331,2116 @@ TEST(LifeFixture, life_const_end3) {
 	--c1;;
 	ASSERT_EQ((*c1).is_alive(), false); ASSERT_EQ((*c1).is_border(), false);
 }
+
+TEST(LifeFixture, life_random_access1) {
+	istringstream in("...\n.*.\n...\n*..\n\n");
+
+	const Life<ConwayCell> l(in, 4, 3);
+
+	Life<ConwayCell>::const_iterator<ConwayCell> b = l.begin();
+	Life<ConwayCell>::const_iterator<ConwayCell> e = l.end();
+	ASSERT_EQ(e - b, 12);
+	ASSERT_TRUE(b[4].is_alive());
+	ASSERT_TRUE((b + 9)->is_alive());
+	ASSERT_TRUE((e - 3)->is_alive());
+	ASSERT_TRUE(b + 12 == e);
+	ASSERT_TRUE(b + 5 < e - 6);
+	ASSERT_EQ(std::count_if(b, e, [](const ConwayCell& c) { return c.is_alive(); }), 2);
+
+	Life<ConwayCell>::const_iterator<ConwayCell> c = b;
+	c += 7;
+	c -= 3;
+	ASSERT_TRUE(c == b + 4);
+	++c; ++c; ++c;
+	ASSERT_TRUE(c == b + 7);
+	--c; --c;
+	ASSERT_TRUE(&*c == &l.at(1, 2));
+}
+
+TEST(LifeFixture, life_random_access2) {
+	// the iterators agree with at() cell by cell, forwards and backwards
+	const string board = random_board(9, 13, 263, "*.-0");
+	istringstream in(board);
+	Life<Cell> l(in, 9, 13);
+
+	Life<Cell>::iterator<Cell> it = l.begin();
+	for (int x = 0; x < 9; x++)
+		for (int y = 0; y < 13; y++, ++it) {
+			ASSERT_EQ(&*it, &l.at(x, y));
+			ASSERT_EQ(&l.begin()[x * 13 + y], &l.at(x, y));
+		}
+	ASSERT_TRUE(it == l.end());
+
+	for (int x = 8; x >= 0; x--)
+		for (int y = 12; y >= 0; y--)
+			ASSERT_EQ(&*--it, &l.at(x, y));
+	ASSERT_TRUE(it == l.begin());
+}
+
+TEST(LifeFixture, life_random_access3) {
+	// the standard algorithms that need random access, and every comparison
+	istringstream in(random_board(7, 11, 269, "*."));
+	Life<ConwayCell> l(in, 7, 11);
+	const int population = l.population();
+	const auto dead_first = [](const ConwayCell& a, const ConwayCell& b) { return !a.is_alive() && b.is_alive(); };
+
+	std::sort(l.begin(), l.end(), dead_first);
+	const Life<ConwayCell>& cl = l;
+	Life<ConwayCell>::const_iterator<ConwayCell> b = cl.begin();
+	Life<ConwayCell>::const_iterator<ConwayCell> e = cl.end();
+	ASSERT_TRUE(std::is_sorted(b, e, dead_first));
+
+	const Life<ConwayCell>::const_iterator<ConwayCell> first_alive = std::lower_bound(b, e, ConwayCell('*'), dead_first);
+	ASSERT_EQ(e - first_alive, population);
+	ASSERT_TRUE(first_alive == 77 - population + b);
+	ASSERT_TRUE(e > first_alive && first_alive >= b && b <= b && e >= e && !(b > e));
+
+	Life<ConwayCell>::const_iterator<ConwayCell> c = b;
+	ASSERT_TRUE(c++ == b);
+	ASSERT_TRUE(c-- == b + 1);
+	ASSERT_TRUE(c == b);
+}
+
+TEST(LifeFixture, life_row1) {
+	istringstream in("...\n.*.\n...\n\n");
+
+	Life<ConwayCell> l(in, 3, 3);
+	const Life<ConwayCell>& cl = l;
+
+	Life<ConwayCell>::span<const ConwayCell> r = cl.row(1);
+	ASSERT_EQ(r.size(), 3);
+	ASSERT_EQ(r.data(), &l.at(1, 0));
+	ASSERT_TRUE(r[1].is_alive());
+	ASSERT_EQ(std::count_if(r.begin(), r.end(), [](const ConwayCell& c) { return c.is_alive(); }), 1);
+
+	// a blinker written through row() is evolved like any other
+	for (ConwayCell& c : l.row(1))
+		c = ConwayCell('*');
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1, Population = 3.\n.*.\n.*.\n.*.\n\n");
+}
+
+// -----------
+// BitLifeTest
+// -----------
+
+TEST(BitLifeFixture, bitlife_print1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	BitLife l(in, 3, 3);
+	ostringstream s;
+	l.print(s);
+	ASSERT_EQ(s.str(), "Generation = 0, Population = 3.\n.*.\n.*.\n.*.\n\n");
+}
+
+TEST(BitLifeFixture, bitlife_evolve_all1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	BitLife l(in, 3, 3);
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1, Population = 3.\n...\n***\n...\n\n");
+}
+
+TEST(BitLifeFixture, bitlife_evolve_all2) {
+	// 130 columns, so live cells cross both word boundaries
+	const string board = random_board(17, 130, 7, "*.");
+
+	istringstream in1(board);
+	istringstream in2(board);
+	Life<ConwayCell> l1(in1, 17, 130);
+	BitLife l2(in2, 17, 130);
+
+	for (int i = 0; i < 40; i++) {
+		ostringstream out1;
+		ostringstream out2;
+		l1.print(out1);
+		l2.print(out2);
+		ASSERT_EQ(out1.str(), out2.str());
+
+		l1.evolve_all();
+		l2.evolve_all();
+	}
+}
+
+TEST(BitLifeFixture, bitlife_evolve_all3) {
+	istringstream in("****************************************************************\n"
+	                 "****************************************************************\n\n");
+
+	BitLife l(in, 2, 64);
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1, Population = 4.\n"
+	                     "*..............................................................*\n"
+	                     "*..............................................................*\n\n");
+}
+
+TEST(BitLifeFixture, bitlife_at1) {
+	istringstream in("...\n.*.\n...\n*..\n\n");
+
+	BitLife l(in, 4, 3);
+
+	ASSERT_EQ(l.at(0, 0).is_alive(), false); ASSERT_EQ(l.at(0, 0).is_border(), false);
+	ASSERT_EQ(l.at(1, 1).is_alive(), true);
+	ASSERT_EQ(l.at(3, 0).is_alive(), true);
+
+	l.at(0, 0) = ConwayCell('*');
+	l.at(3, 0) = l.at(2, 0);
+	ASSERT_EQ(l.at(0, 0).is_alive(), true);
+	ASSERT_EQ(l.at(3, 0).is_alive(), false);
+
+	const BitLife& cl = l;
+	ConwayCell c = cl.at(1, 1);
+	ASSERT_EQ(c.is_alive(), true); ASSERT_EQ(c.is_border(), false);
+
+	ostringstream s;
+	s << l.at(1, 1) << l.at(1, 2);
+	ASSERT_EQ(s.str(), "*.");
+}
+
+TEST(BitLifeFixture, bitlife_iterator1) {
+	istringstream in("...\n.*.\n...\n*..\n\n");
+
+	BitLife l(in, 4, 3);
+
+	int alive = 0;
+	int cells = 0;
+	for (BitLife::iterator it = l.begin(); it != l.end(); ++it, ++cells)
+		if ((*it).is_alive())
+			alive++;
+	ASSERT_EQ(cells, 12);
+	ASSERT_EQ(alive, 2);
+
+	BitLife::iterator it = l.end();
+	--it;
+	*it = ConwayCell('*');
+	ASSERT_EQ(l.at(3, 2).is_alive(), true);
+
+	const BitLife& cl = l;
+	BitLife::const_iterator c1 = cl.begin();
+	++c1; ++c1; ++c1; ++c1;
+	ASSERT_EQ((*c1).is_alive(), true);
+}
+
+// ---------------
+// FredkinLifeTest
+// ---------------
+
+TEST(FredkinLifeFixture, fredkin_print1) {
+	istringstream in("-0-\n9-+\n\n");
+
+	FredkinLife l(in, 2, 3);
+	ostringstream s;
+	l.print(s);
+	ASSERT_EQ(s.str(), "Generation = 0, Population = 3.\n-0-\n9-+\n\n");
+}
+
+TEST(FredkinLifeFixture, fredkin_evolve_all1) {
+	// 150 columns, so every kernel runs whole vectors and a scalar tail
+	const string board = random_board(23, 150, 251, "0-");
+
+	const CountKernel best = best_kernel();
+	for (int k = best; k >= SCALAR_KERNEL; k--) {
+		ASSERT_TRUE(use_kernel((CountKernel) k));
+
+		istringstream in1(board);
+		istringstream in2(board);
+		Life<FredkinCell> l1(in1, 23, 150);
+		FredkinLife l2(in2, 23, 150);
+
+		for (int i = 0; i < 60; i++) {
+			ostringstream out1;
+			ostringstream out2;
+			l1.print(out1);
+			l2.print(out2);
+			ASSERT_EQ(out1.str(), out2.str()) << "kernel " << k << ", generation " << i;
+			ASSERT_EQ(l1.population(), l2.population());
+
+			l1.evolve_all();
+			l2.evolve_all();
+		}
+	}
+	use_kernel(best);
+}
+
+TEST(FredkinLifeFixture, fredkin_at1) {
+	istringstream in("00\n--\n\n");
+
+	FredkinLife l(in, 2, 2);
+	ASSERT_EQ(l.at(0, 1), FredkinCell(0, true));
+	ASSERT_EQ(l.at(1, 0), FredkinCell(0, false));
+
+	// both live cells have one live neighbor and get older, the dead ones below are born
+	l.evolve(1);
+	ASSERT_EQ(l.generation(), 1);
+	ASSERT_EQ(l.at(0, 0), FredkinCell(1, true));
+	ASSERT_EQ(l.at(1, 1), FredkinCell(0, true));
+	ASSERT_EQ(l.at(0, 0).symbol(), '1');
+}
+
+TEST(FredkinLifeFixture, fredkin_step1) {
+	// up, mid at column -1 to 2 and down, age 127 is the oldest a cell gets
+	const unsigned char up[] = {0, 1, 0, 0};
+	const unsigned char mid[] = {0, 0xff, 0x14, 0};
+	const unsigned char down[] = {0, 0, 0, 0};
+
+	unsigned char out[2];
+	fredkin_step(up + 1, mid + 1, down + 1, out, 2);
+	ASSERT_EQ(out[0], 0xff);
+	ASSERT_EQ(out[1], 0x15);
+}
+
+// -----------------
+// NeighborCountTest
+// -----------------
+
+TEST(NeighborCountFixture, kernels_match_scalar) {
+	// rows of random bytes, only bit 0 is the alive flag
+	vector<unsigned char> plane(3 * 202);
+	unsigned seed = 3;
+	for (unsigned char& c : plane) {
+		seed = seed * 1103515245 + 12345;
+		c = seed >> 16;
+	}
+	const unsigned char* up = &plane[1];
+	const unsigned char* mid = up + 202;
+	const unsigned char* down = mid + 202;
+
+	const CountKernel best = best_kernel();
+	for (int n = 0; n <= 200; n++) {
+		vector<unsigned char> moore(n + 1, 0xff), von_neumann(n + 1, 0xff), fredkin(n + 1, 0xff);
+		ASSERT_TRUE(use_kernel(SCALAR_KERNEL));
+		moore_counts(up, mid, down, &moore[0], n);
+		von_neumann_counts(up, mid, down, &von_neumann[0], n);
+		fredkin_step(up, mid, down, &fredkin[0], n);
+		ASSERT_EQ(moore[n], 0xff);
+		ASSERT_EQ(fredkin[n], 0xff);
+
+		for (int k = SSE2_KERNEL; k <= best; k++) {
+			vector<unsigned char> m(n + 1, 0xff), v(n + 1, 0xff), f(n + 1, 0xff);
+			ASSERT_TRUE(use_kernel((CountKernel) k));
+			moore_counts(up, mid, down, &m[0], n);
+			von_neumann_counts(up, mid, down, &v[0], n);
+			fredkin_step(up, mid, down, &f[0], n);
+			ASSERT_EQ(m, moore) << "kernel " << k << ", n = " << n;
+			ASSERT_EQ(v, von_neumann) << "kernel " << k << ", n = " << n;
+			ASSERT_EQ(f, fredkin) << "kernel " << k << ", n = " << n;
+		}
+	}
+	use_kernel(best);
+}
+
+TEST(NeighborCountFixture, kernel_counts1) {
+	const unsigned char plane[] = {
+		1, 1, 0,
+		0, 1, 1,
+		1, 1, 1};
+
+	unsigned char moore = 0xff;
+	unsigned char von_neumann = 0xff;
+	moore_counts(plane + 1, plane + 4, plane + 7, &moore, 1);
+	von_neumann_counts(plane + 1, plane + 4, plane + 7, &von_neumann, 1);
+	ASSERT_EQ(moore, 6);
+	ASSERT_EQ(von_neumann, 3);
+}
+
+TEST(NeighborCountFixture, use_kernel1) {
+	ASSERT_TRUE(use_kernel(SCALAR_KERNEL));
+	ASSERT_EQ(active_kernel(), SCALAR_KERNEL);
+	ASSERT_TRUE(use_kernel(best_kernel()));
+	ASSERT_EQ(active_kernel(), best_kernel());
+}
+
+TEST(NeighborCountFixture, life_kernels1) {
+	const string board = random_board(23, 150, 11, "*.");
+	const string fredkin = random_board(23, 150, 13, "0-");
+
+	const CountKernel best = best_kernel();
+	string expected;
+	for (int k = best; k >= SCALAR_KERNEL; k--) {
+		ASSERT_TRUE(use_kernel((CountKernel) k));
+
+		istringstream in1(board);
+		istringstream in2(fredkin);
+		Life<ConwayCell> l1(in1, 23, 150);
+		Life<FredkinCell> l2(in2, 23, 150);
+
+		ostringstream out;
+		for (int i = 0; i < 20; i++) {
+			l1.evolve_all();
+			l2.evolve_all();
+			l1.print(out);
+			l2.print(out);
+		}
+
+		if (k == best)
+			expected = out.str();
+		else
+			ASSERT_EQ(out.str(), expected) << "kernel " << k;
+	}
+	use_kernel(best);
+}
+
+TEST(NeighborCountFixture, life_kernels2) {
+	// writes through at() between generations are seen by the next one
+	istringstream in(".....\n.....\n.....\n.....\n.....\n\n");
+
+	Life<ConwayCell> l(in, 5, 5);
+	l.evolve_all();
+
+	l.at(2, 1) = ConwayCell('*');
+	l.at(2, 2) = ConwayCell('*');
+	l.at(2, 3) = ConwayCell('*');
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 2, Population = 3.\n.....\n..*..\n..*..\n..*..\n.....\n\n");
+}
+
+// --------------
+// ThreadPoolTest
+// --------------
+
+TEST(ThreadPoolFixture, thread_pool_run1) {
+	ThreadPool pool(4);
+	ASSERT_EQ(pool.size(), 4);
+
+	vector<int> hits(4, 0);
+	for (int round = 0; round < 100; round++)
+		pool.run([&hits](int i) { hits[i]++; });
+
+	ASSERT_EQ(hits, vector<int>(4, 100));
+}
+
+template <class T>
+string evolve_threads(const string& board, int h, int w, int threads, int generations) {
+	istringstream in(board);
+	Life<T> l(in, h, w);
+	l.set_threads(threads);
+
+	ostringstream out;
+	for (int i = 0; i < generations; i++) {
+		l.evolve_all();
+		l.print(out);
+	}
+	return out.str();
+}
+
+TEST(ThreadPoolFixture, life_threads1) {
+	const string board = random_board(37, 41, 17, "*.");
+	const string expected = evolve_threads<ConwayCell>(board, 37, 41, 1, 30);
+
+	for (int n = 2; n <= 5; n++)
+		ASSERT_EQ(evolve_threads<ConwayCell>(board, 37, 41, n, 30), expected) << n << " threads";
+}
+
+TEST(ThreadPoolFixture, life_threads2) {
+	const string board = random_board(19, 23, 19, "0-");
+	ASSERT_EQ(evolve_threads<FredkinCell>(board, 19, 23, 3, 10), evolve_threads<FredkinCell>(board, 19, 23, 1, 10));
+}
+
+TEST(ThreadPoolFixture, life_threads3) {
+	// more workers than rows leaves some bands empty
+	const string board = random_board(5, 9, 23, "*.-0");
+	ASSERT_EQ(evolve_threads<Cell>(board, 5, 9, 8, 10), evolve_threads<Cell>(board, 5, 9, 1, 10));
+}
+
+TEST(ThreadPoolFixture, life_threads4) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	Life<ConwayCell> l(in, 3, 3);
+	ASSERT_EQ(l.threads(), 1);
+	l.set_threads(3);
+	ASSERT_EQ(l.threads(), 3);
+	l.evolve_all();
+	l.set_threads(0);
+	ASSERT_EQ(l.threads(), 1);
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 2, Population = 3.\n.*.\n.*.\n.*.\n\n");
+}
+
+TEST(ThreadPoolFixture, life_threads5) {
+	// a copy evolves on a pool of its own, with as many workers
+	istringstream in(random_board(29, 31, 27, "*."));
+	Life<ConwayCell> a(in, 29, 31);
+	Life<ConwayCell> b = a;
+	ASSERT_EQ(b.threads(), 1);
+
+	a.set_threads(4);
+	a.evolve_all();
+	Life<ConwayCell> c = a;
+	ASSERT_EQ(c.threads(), 4);
+	b = a;
+	ASSERT_EQ(b.threads(), 4);
+
+	a.evolve_n(5);
+	b.evolve_n(5);
+	c.set_threads(1);
+	c.evolve_n(5);
+
+	ostringstream out_a, out_b, out_c;
+	a.print(out_a);
+	b.print(out_b);
+	c.print(out_c);
+	ASSERT_EQ(out_b.str(), out_a.str());
+	ASSERT_EQ(out_c.str(), out_a.str());
+}
+
+// ------------
+// HashLifeTest
+// ------------
+
+TEST(HashLifeFixture, hashlife_print1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	HashLife l(in, 3, 3);
+	ostringstream s;
+	l.print(s);
+	ASSERT_EQ(s.str(), "Generation = 0, Population = 3.\n.*.\n.*.\n.*.\n\n");
+}
+
+TEST(HashLifeFixture, hashlife_evolve_all1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	HashLife l(in, 3, 3);
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1, Population = 3.\n...\n***\n...\n\n");
+}
+
+TEST(HashLifeFixture, hashlife_evolve_all2) {
+	// a random soup in the middle of a big empty window, it never reaches the edge
+	string board;
+	const string soup = random_board(12, 12, 41, "*.");
+	istringstream rows(soup);
+	for (int x = 0; x < 64; x++) {
+		string row(64, '.');
+		if (x >= 26 && x < 38) {
+			string line;
+			getline(rows, line);
+			row.replace(26, 12, line);
+		}
+		board += row + '\n';
+	}
+	board += '\n';
+
+	istringstream in1(board);
+	istringstream in2(board);
+	Life<ConwayCell> l1(in1, 64, 64);
+	HashLife l2(in2, 64, 64);
+
+	for (int i = 0; i < 24; i++) {
+		ostringstream out1;
+		ostringstream out2;
+		l1.print(out1);
+		l2.print(out2);
+		ASSERT_EQ(out1.str(), out2.str()) << "generation " << i;
+
+		l1.evolve_all();
+		l2.evolve_all();
+	}
+}
+
+TEST(HashLifeFixture, hashlife_evolve_pow2) {
+	// a glider, 2^10 generations later it is 256 cells down and right
+	istringstream in(".*...\n..*..\n***..\n.....\n.....\n\n");
+
+	HashLife l(in, 5, 5);
+	l.evolve_pow2(10);
+
+	ASSERT_EQ(l.generation(), 1024);
+	ASSERT_EQ(l.population(), 5);
+	ASSERT_EQ(l.at(256, 257).is_alive(), true);
+	ASSERT_EQ(l.at(257, 258).is_alive(), true);
+	ASSERT_EQ(l.at(258, 256).is_alive(), true);
+	ASSERT_EQ(l.at(258, 257).is_alive(), true);
+	ASSERT_EQ(l.at(258, 258).is_alive(), true);
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1024, Population = 0.\n.....\n.....\n.....\n.....\n.....\n\n");
+}
+
+TEST(HashLifeFixture, hashlife_evolve1) {
+	// stepping by powers of two matches stepping one generation at a time
+	const string soup = random_board(16, 16, 43, "*.");
+
+	istringstream in1(soup);
+	istringstream in2(soup);
+	HashLife l1(in1, 16, 16);
+	HashLife l2(in2, 16, 16);
+
+	l1.evolve(100);
+	for (int i = 0; i < 100; i++)
+		l2.evolve_all();
+
+	ASSERT_EQ(l1.generation(), 100);
+	ASSERT_EQ(l1.population(), l2.population());
+	for (int x = -100; x < 116; x++)
+		for (int y = -100; y < 116; y++)
+			ASSERT_EQ(l1.at(x, y).is_alive(), l2.at(x, y).is_alive()) << x << ", " << y;
+}
+
+TEST(HashLifeFixture, hashlife_collect1) {
+	const string soup = random_board(16, 16, 47, "*.");
+
+	istringstream in(soup);
+	HashLife l(in, 16, 16);
+	l.evolve(50);
+	const long long population = l.population();
+	const size_t nodes = l.nodes();
+
+	l.collect();
+	ASSERT_LT(l.nodes(), nodes);
+	ASSERT_EQ(l.population(), population);
+
+	l.evolve(50);
+	istringstream in2(soup);
+	HashLife l2(in2, 16, 16);
+	l2.evolve(100);
+	ASSERT_EQ(l.population(), l2.population());
+}
+
+// ------------
+// TrackingTest
+// ------------
+
+template <class T>
+string evolve_tracked(const string& board, int h, int w, int tile, int threads, int generations) {
+	istringstream in(board);
+	Life<T> l(in, h, w);
+	l.set_tracking(tile);
+	l.set_threads(threads);
+
+	ostringstream out;
+	for (int i = 0; i < generations; i++) {
+		l.evolve_all();
+		l.print(out);
+	}
+	return out.str();
+}
+
+TEST(TrackingFixture, cell_equal1) {
+	ASSERT_TRUE(ConwayCell('*') == ConwayCell('*'));
+	ASSERT_FALSE(ConwayCell('*') == ConwayCell('.'));
+	ASSERT_TRUE(FredkinCell(3, true) == FredkinCell(3, true));
+	ASSERT_FALSE(FredkinCell(3, true) == FredkinCell(4, true));
+	ASSERT_FALSE(FredkinCell(3, true) == FredkinCell(3, false));
+}
+
+TEST(TrackingFixture, set_tracking1) {
+	istringstream in1(".*.\n.*.\n.*.\n\n");
+	istringstream in2(".*.\n.*.\n.*.\n\n");
+
+	Life<ConwayCell> l1(in1, 3, 3);
+	Life<Cell> l2(in2, 3, 3);
+	ASSERT_EQ(l1.tracking(), 0);
+	ASSERT_TRUE(l1.set_tracking(2));
+	ASSERT_EQ(l1.tracking(), 2);
+	ASSERT_FALSE(l1.set_tracking(0));
+	ASSERT_EQ(l1.tracking(), 0);
+	ASSERT_FALSE(l2.set_tracking(2));
+	ASSERT_EQ(l2.tracking(), 0);
+}
+
+TEST(TrackingFixture, tracking_evolve1) {
+	const string board = random_board(37, 41, 29, "*.");
+	const string expected = evolve_threads<ConwayCell>(board, 37, 41, 1, 60);
+
+	for (int tile = 1; tile <= 64; tile *= 4)
+		ASSERT_EQ(evolve_tracked<ConwayCell>(board, 37, 41, tile, 1, 60), expected) << tile << " tile";
+}
+
+TEST(TrackingFixture, tracking_evolve2) {
+	const string board = random_board(19, 23, 31, "0-");
+	ASSERT_EQ(evolve_tracked<FredkinCell>(board, 19, 23, 4, 1, 15), evolve_threads<FredkinCell>(board, 19, 23, 1, 15));
+}
+
+TEST(TrackingFixture, tracking_threads1) {
+	const string board = random_board(37, 41, 37, "*.");
+	ASSERT_EQ(evolve_tracked<ConwayCell>(board, 37, 41, 8, 3, 40), evolve_threads<ConwayCell>(board, 37, 41, 1, 40));
+}
+
+TEST(TrackingFixture, tracking_skip1) {
+	// a block in the top-left tile and a blinker in the bottom-right one
+	string board;
+	for (int x = 0; x < 32; x++) {
+		string row(32, '.');
+		if (x == 1 || x == 2)
+			row.replace(1, 2, "**");
+		if (x == 27)
+			row.replace(26, 3, "***");
+		board += row + '\n';
+	}
+	board += '\n';
+
+	istringstream in(board);
+	Life<ConwayCell> l(in, 32, 32);
+	l.set_tracking(8);
+
+	l.evolve_all();
+	ASSERT_EQ(l.active_tiles(), 16);
+	l.evolve_all();
+	ASSERT_EQ(l.active_tiles(), 4);	// only the blinker's tile changed, it has 3 neighbor tiles
+	l.evolve_all();
+	ASSERT_EQ(l.active_tiles(), 4);
+
+	const Life<ConwayCell>& c = l;
+	ASSERT_TRUE(c.at(26, 27).is_alive());
+	ASSERT_TRUE(c.at(1, 1).is_alive());
+
+	// changing a cell through at() evolves every tile again
+	l.at(15, 15) = ConwayCell('*');
+	l.evolve_all();
+	ASSERT_EQ(l.active_tiles(), 16);
+	ASSERT_FALSE(c.at(15, 15).is_alive());
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str().substr(0, 68), "Generation = 4, Population = 7.\n" + string(32, '.') + "\n.**");
+}
+
+// -------------
+// TiledLifeTest
+// -------------
+
+template <class T>
+string evolve_tiled(const string& board, int h, int w, int tile, int halo, int step, int generations) {
+	istringstream in(board);
+	TiledLife<T> l(in, h, w, tile, halo);
+
+	ostringstream out;
+	for (int i = 0; i < generations; i += step) {
+		l.evolve(step);
+		l.print(out);
+	}
+	return out.str();
+}
+
+template <class T>
+string evolve_every(const string& board, int h, int w, int step, int generations) {
+	istringstream in(board);
+	Life<T> l(in, h, w);
+
+	ostringstream out;
+	for (int i = 0; i < generations; i++) {
+		l.evolve_all();
+		if ((i + 1) % step == 0)
+			l.print(out);
+	}
+	return out.str();
+}
+
+TEST(TiledLifeFixture, tiled_print1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+
+	TiledLife<ConwayCell> l(in, 3, 3, 2, 1);
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 0, Population = 3.\n.*.\n.*.\n.*.\n\n");
+
+	l.evolve_all();
+	ostringstream out2;
+	l.print(out2);
+	ASSERT_EQ(out2.str(), "Generation = 1, Population = 3.\n...\n***\n...\n\n");
+}
+
+TEST(TiledLifeFixture, tiled_evolve1) {
+	// tiles that do not divide the board, one generation per halo exchange
+	const string board = random_board(37, 41, 53, "*.");
+	ASSERT_EQ(evolve_tiled<ConwayCell>(board, 37, 41, 8, 1, 1, 40), evolve_every<ConwayCell>(board, 37, 41, 1, 40));
+}
+
+TEST(TiledLifeFixture, tiled_evolve2) {
+	// several generations per halo exchange
+	const string board = random_board(37, 41, 59, "*.");
+	ASSERT_EQ(evolve_tiled<ConwayCell>(board, 37, 41, 16, 4, 4, 40), evolve_every<ConwayCell>(board, 37, 41, 4, 40));
+	ASSERT_EQ(evolve_tiled<ConwayCell>(board, 37, 41, 5, 5, 10, 40), evolve_every<ConwayCell>(board, 37, 41, 10, 40));
+}
+
+TEST(TiledLifeFixture, tiled_evolve3) {
+	const string board = random_board(19, 23, 61, "0-");
+	ASSERT_EQ(evolve_tiled<FredkinCell>(board, 19, 23, 6, 3, 3, 15), evolve_every<FredkinCell>(board, 19, 23, 3, 15));
+}
+
+TEST(TiledLifeFixture, tiled_evolve4) {
+	const string board = random_board(13, 17, 67, "*.-0");
+	ASSERT_EQ(evolve_tiled<Cell>(board, 13, 17, 4, 2, 2, 12), evolve_every<Cell>(board, 13, 17, 2, 12));
+	ASSERT_EQ(evolve_tiled<MixedCell>(board, 13, 17, 4, 2, 2, 12), evolve_every<MixedCell>(board, 13, 17, 2, 12));
+}
+
+TEST(TiledLifeFixture, tiled_at1) {
+	istringstream in("....\n....\n....\n\n");
+
+	TiledLife<ConwayCell> l(in, 3, 4, 2, 2);
+	l.at(0, 1) = ConwayCell('*');
+	l.at(1, 1) = ConwayCell('*');
+	l.at(2, 1) = ConwayCell('*');
+	l.evolve(2);
+
+	const TiledLife<ConwayCell>& c = l;
+	ASSERT_TRUE(c.at(1, 0).is_alive() == false);
+	ASSERT_TRUE(c.at(0, 1).is_alive());
+	ASSERT_TRUE(c.at(1, 1).is_alive());
+	ASSERT_TRUE(c.at(2, 1).is_alive());
+	ASSERT_TRUE(c.at(1, 2).is_alive() == false);
+}
+
+TEST(TiledLifeFixture, tiled_iterator1) {
+	const string board = random_board(7, 9, 71, "*.");
+	istringstream in1(board);
+	istringstream in2(board);
+
+	Life<ConwayCell> l1(in1, 7, 9);
+	TiledLife<ConwayCell> l2(in2, 7, 9, 4, 2);
+
+	Life<ConwayCell>::iterator<ConwayCell> b1 = l1.begin();
+	TiledLife<ConwayCell>::iterator b2 = l2.begin();
+	int n = 0;
+	for (; b2 != l2.end(); ++b1, ++b2, ++n)
+		ASSERT_EQ((*b1).is_alive(), (*b2).is_alive());
+	ASSERT_EQ(n, 63);
+
+	const TiledLife<ConwayCell>& c = l2;
+	TiledLife<ConwayCell>::const_iterator e = c.end();
+	--e;
+	ASSERT_EQ((*e).is_alive(), l1.at(6, 8).is_alive());
+}
+
+// --------
+// LoadTest
+// --------
+
+TEST(LoadFixture, life_load1) {
+	// boards read back to back from one stream, the way RunLife reads them
+	istringstream in(".*.\n.*.\n.*.\n\n0-\n-+\n\n*-\n.9\n\n");
+
+	Life<ConwayCell> l1(in, 3, 3);
+	Life<FredkinCell> l2(in, 2, 2);
+	Life<Cell> l3(in, 2, 2);
+
+	ostringstream out;
+	l1.print(out);
+	l2.print(out);
+	l3.print(out);
+	ASSERT_EQ(out.str(), "Generation = 0, Population = 3.\n.*.\n.*.\n.*.\n\n"
+	                     "Generation = 0, Population = 2.\n0-\n-+\n\n"
+	                     "Generation = 0, Population = 2.\n*-\n.9\n\n");
+	ASSERT_EQ(in.peek(), EOF);
+}
+
+TEST(LoadFixture, life_load2) {
+	// the last board of a file does not need the blank line
+	istringstream in("*.\n.*\n");
+
+	Life<ConwayCell> l(in, 2, 2);
+	ASSERT_TRUE(l.at(0, 0).is_alive());
+	ASSERT_FALSE(l.at(0, 1).is_alive());
+	ASSERT_TRUE(l.at(1, 1).is_alive());
+}
+
+TEST(LoadFixture, life_load3) {
+	const string board = random_board(37, 41, 73, "*.-0");
+	istringstream in(board);
+
+	Life<Cell> l1(in, 37, 41);
+	Life<Cell> l2(board.data(), board.size(), 37, 41);
+
+	for (int i = 0; i < 5; i++) {
+		ostringstream out1;
+		ostringstream out2;
+		l1.print(out1);
+		l2.print(out2);
+		ASSERT_EQ(out1.str(), out2.str());
+
+		l1.evolve_all();
+		l2.evolve_all();
+	}
+}
+
+// --------------
+// MappedFileTest
+// --------------
+
+TEST(MappedFileFixture, cell_symbol1) {
+	ASSERT_EQ(ConwayCell('*').symbol(), '*');
+	ASSERT_EQ(ConwayCell('.').symbol(), '.');
+	ASSERT_EQ(FredkinCell('-').symbol(), '-');
+	ASSERT_EQ(FredkinCell('7').symbol(), '7');
+	ASSERT_EQ(FredkinCell(12, true).symbol(), '+');
+	ASSERT_EQ(Cell('3').symbol(), '3');
+	ASSERT_EQ(MixedCell('+').symbol(), '+');
+}
+
+TEST(MappedFileFixture, life_print_region1) {
+	const string board = random_board(7, 9, 79, "*.-0");
+	istringstream in(board);
+
+	Life<Cell> l(in, 7, 9);
+	string region(7 * 10 * 2, 'x');
+	char* end = l.print(&region[0]);
+	l.evolve_all();
+	end = l.print(end);
+	ASSERT_EQ(end, &region[0] + region.size());
+
+	ASSERT_EQ(region.substr(0, 70) + "\n", board);
+
+	// the same rows print(ostream&) writes after its header
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(region.substr(70), out.str().substr(out.str().find('\n') + 1, 70));
+}
+
+TEST(MappedFileFixture, mapped_file1) {
+	char name[] = "/tmp/MappedFileXXXXXX";
+	const int fd = mkstemp(name);
+	ASSERT_GE(fd, 0);
+	close(fd);
+
+	const string board = random_board(37, 41, 83, "*.");
+	{
+		MappedFile out(name, board.size() - 1);
+		ASSERT_EQ(out.size(), board.size() - 1);
+		istringstream in(board);
+		Life<ConwayCell> l(in, 37, 41);
+		ASSERT_EQ(l.print(out.data()), out.data() + out.size());
+		out.sync();
+	}
+	{
+		const MappedFile in(name);
+		ASSERT_EQ(string(in.data(), in.size()) + "\n", board);
+
+		Life<ConwayCell> l(in.data(), in.size(), 37, 41);
+		ostringstream out1;
+		l.print(out1);
+
+		istringstream s(board);
+		Life<ConwayCell> l2(s, 37, 41);
+		ostringstream out2;
+		l2.print(out2);
+		ASSERT_EQ(out1.str(), out2.str());
+	}
+
+	unlink(name);
+	ASSERT_THROW(MappedFile m(name), system_error);
+}
+
+// -------
+// RLETest
+// -------
+
+/**
+ * decode an RLE pattern back into the text board format, for the tests only
+ */
+string decode_rle(const string& rle, int h, int w) {
+	vector<string> rows(h, string(w, '.'));
+	int x = 0;
+	int y = 0;
+	int run = 0;
+	for (size_t i = rle.find('\n') + 1; i < rle.size() && rle[i] != '!'; i++) {
+		const char c = rle[i];
+		if (c >= '0' && c <= '9')
+			run = run * 10 + (c - '0');
+		else if (c == '$') {
+			x += run ? run : 1;
+			y = 0;
+			run = 0;
+		} else if (c == 'o' || c == 'b') {
+			for (int k = 0; k < (run ? run : 1); k++)
+				rows[x][y++] = (c == 'o') ? '*' : '.';
+			run = 0;
+		}
+	}
+
+	string board;
+	for (const string& row : rows)
+		board += row + '\n';
+	return board + '\n';
+}
+
+TEST(RLEFixture, life_print_rle1) {
+	istringstream in(".*...\n..*..\n***..\n.....\n.....\n\n");
+
+	Life<ConwayCell> l(in, 5, 5);
+	ostringstream out;
+	l.print_rle(out);
+	ASSERT_EQ(out.str(), "x = 5, y = 5, rule = B3/S23\nbo$2bo$3o!\n");
+}
+
+TEST(RLEFixture, life_print_rle2) {
+	// empty rows in the middle are merged, the ones at the end are left out
+	istringstream in("*..\n...\n...\n..*\n...\n\n");
+
+	Life<ConwayCell> l(in, 5, 3);
+	ostringstream out;
+	l.print_rle(out);
+	ASSERT_EQ(out.str(), "x = 3, y = 5, rule = B3/S23\no3$2bo!\n");
+}
+
+TEST(RLEFixture, life_print_rle3) {
+	const string board = random_board(23, 97, 89, "*.");
+	istringstream in(board);
+
+	Life<ConwayCell> l(in, 23, 97);
+	ostringstream out;
+	l.print_rle(out);
+
+	istringstream lines(out.str());
+	string line;
+	while (getline(lines, line))
+		ASSERT_LE(line.size(), 70u);
+	ASSERT_EQ(decode_rle(out.str(), 23, 97), board);
+}
+
+TEST(RLEFixture, life_print_buffered1) {
+	// one write per print, the same text as before
+	istringstream in("-0\n+-\n\n");
+
+	const Life<FredkinCell> l(in, 2, 2);
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 0, Population = 2.\n-0\n+-\n\n");
+}
+
+// --------------
+// CheckpointTest
+// --------------
+
+template <class T>
+void checkpoint_round_trip(const string& board, int h, int w, int generations) {
+	istringstream in(board);
+	Life<T> l1(in, h, w);
+	for (int i = 0; i < generations; i++)
+		l1.evolve_all();
+
+	stringstream checkpoint;
+	l1.save(checkpoint);
+	ASSERT_EQ(checkpoint.str().size(), Life<T>::checkpoint_size(h, w));
+
+	Life<T> l2(checkpoint);
+	for (int i = 0; i < 3; i++) {
+		ostringstream out1;
+		ostringstream out2;
+		l1.print(out1);
+		l2.print(out2);
+		ASSERT_EQ(out1.str(), out2.str());
+
+		l1.evolve_all();
+		l2.evolve_all();
+	}
+}
+
+TEST(CheckpointFixture, checkpoint_conway1) {
+	checkpoint_round_trip<ConwayCell>(random_board(37, 41, 97, "*."), 37, 41, 7);
+	ASSERT_EQ(Life<ConwayCell>::checkpoint_size(37, 41), 40u + (37 * 41 + 7) / 8);
+}
+
+TEST(CheckpointFixture, checkpoint_fredkin1) {
+	// ages past 9 print as +, the checkpoint keeps them
+	istringstream in("000\n000\n000\n\n");
+	Life<FredkinCell> l1(in, 3, 3);
+	for (int i = 0; i < 12; i++)
+		l1.evolve_all();
+
+	stringstream checkpoint;
+	l1.save(checkpoint);
+	const Life<FredkinCell> l2(checkpoint);
+	for (int x = 0; x < 3; x++)
+		for (int y = 0; y < 3; y++) {
+			ASSERT_EQ(l2.at(x, y).age(), l1.at(x, y).age());
+			ASSERT_EQ(l2.at(x, y).is_alive(), l1.at(x, y).is_alive());
+		}
+
+	checkpoint_round_trip<FredkinCell>(random_board(19, 23, 101, "0-"), 19, 23, 20);
+}
+
+TEST(CheckpointFixture, checkpoint_cell1) {
+	checkpoint_round_trip<Cell>(random_board(13, 17, 103, "*.-0"), 13, 17, 9);
+	checkpoint_round_trip<MixedCell>(random_board(13, 17, 107, "*.-0"), 13, 17, 9);
+}
+
+TEST(CheckpointFixture, checkpoint_memory1) {
+	const string board = random_board(9, 70, 109, "*.");
+	istringstream in(board);
+	Life<ConwayCell> l1(in, 9, 70);
+	l1.evolve_all();
+
+	vector<char> buffer(Life<ConwayCell>::checkpoint_size(9, 70));
+	ASSERT_EQ(l1.save(buffer.data()), buffer.data() + buffer.size());
+	ASSERT_EQ(string(buffer.data(), 4), "LIFE");
+
+	Life<ConwayCell> l2(buffer.data(), buffer.size());
+	ostringstream out1;
+	ostringstream out2;
+	l1.print(out1);
+	l2.print(out2);
+	ASSERT_EQ(out1.str(), out2.str());
+}
+
+TEST(CheckpointFixture, checkpoint_errors1) {
+	istringstream in("*.\n.*\n\n");
+	Life<ConwayCell> l(in, 2, 2);
+	stringstream checkpoint;
+	l.save(checkpoint);
+	const string bytes = checkpoint.str();
+
+	// another cell type
+	istringstream s1(bytes);
+	ASSERT_THROW(Life<FredkinCell> f(s1), runtime_error);
+
+	// not a checkpoint
+	istringstream s2("*.\n.*\n\n");
+	ASSERT_THROW(Life<ConwayCell> c(s2), runtime_error);
+
+	// truncated
+	ASSERT_THROW(Life<ConwayCell> c(bytes.data(), bytes.size() - 1), runtime_error);
+
+	// the population does not match the cells
+	string corrupt = bytes;
+	corrupt[24] = 3;
+	ASSERT_THROW(Life<ConwayCell> c(corrupt.data(), corrupt.size()), runtime_error);
+}
+
+TEST(CheckpointFixture, checkpoint_errors2) {
+	// a corrupt height and width are refused before anything is sized from them
+	istringstream in("*.\n.*\n\n");
+	Life<ConwayCell> l(in, 2, 2);
+	stringstream checkpoint;
+	l.save(checkpoint);
+	const string bytes = checkpoint.str();
+
+	string huge = bytes;
+	fill(huge.begin() + 8, huge.begin() + 16, '\x7f');
+	istringstream s1(huge);
+	ASSERT_THROW(Life<ConwayCell> c(s1), runtime_error);
+	ASSERT_THROW(Life<ConwayCell> c(huge.data(), huge.size()), runtime_error);
+
+	// a negative height and width, h * w is 1
+	string negative = bytes;
+	fill(negative.begin() + 8, negative.begin() + 16, '\xff');
+	istringstream s2(negative);
+	ASSERT_THROW(Life<ConwayCell> c(s2), runtime_error);
+	ASSERT_THROW(Life<ConwayCell> c(negative.data(), negative.size()), runtime_error);
+}
+
+// -----------
+// EvolveNTest
+// -----------
+
+template <class T>
+void evolve_n_matches(const string& board, int h, int w, int k, int expected_period) {
+	istringstream in1(board);
+	istringstream in2(board);
+	Life<T> l1(in1, h, w);
+	Life<T> l2(in2, h, w);
+
+	const int period = l1.evolve_n(k);
+	for (int i = 0; i < k; i++)
+		l2.evolve_all();
+
+	ostringstream out1;
+	ostringstream out2;
+	l1.print(out1);
+	l2.print(out2);
+	ASSERT_EQ(out1.str(), out2.str());
+	ASSERT_EQ(period, expected_period);
+}
+
+TEST(EvolveNFixture, evolve_n_still1) {
+	evolve_n_matches<ConwayCell>(".....\n.**..\n.**..\n.....\n\n", 4, 5, 1000, 1);
+}
+
+TEST(EvolveNFixture, evolve_n_blinker1) {
+	evolve_n_matches<ConwayCell>(".....\n..*..\n..*..\n..*..\n.....\n\n", 5, 5, 1001, 2);
+	evolve_n_matches<ConwayCell>(".....\n..*..\n..*..\n..*..\n.....\n\n", 5, 5, 1000, 2);
+}
+
+TEST(EvolveNFixture, evolve_n_random1) {
+	// a soup that settles down after a while, and one that runs out of generations first
+	evolve_n_matches<ConwayCell>(random_board(20, 20, 113, "*."), 20, 20, 600, 1);
+	evolve_n_matches<ConwayCell>(random_board(20, 20, 113, "*."), 20, 20, 3, 0);
+}
+
+TEST(EvolveNFixture, evolve_n_fredkin1) {
+	// the ages count, a FredkinCell that survives has changed
+	evolve_n_matches<FredkinCell>(random_board(10, 10, 127, "0-"), 10, 10, 50, 0);
+	evolve_n_matches<FredkinCell>("---\n-0-\n---\n\n", 3, 3, 50, 1);
+	evolve_n_matches<Cell>(random_board(10, 10, 131, "*.-0"), 10, 10, 200, 2);
+}
+
+TEST(EvolveNFixture, evolve_n_period1) {
+	// a blinker is not found when only cycles of 1 are looked for
+	istringstream in(".....\n..*..\n..*..\n..*..\n.....\n\n");
+	Life<ConwayCell> l(in, 5, 5);
+	ASSERT_EQ(l.evolve_n(100, 1), 0);
+	ASSERT_EQ(l.evolve_n(100, 2), 2);
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 200, Population = 3.\n.....\n..*..\n..*..\n..*..\n.....\n\n");
+}
+
+// ---------
+// StatsTest
+// ---------
+
+/**
+ * the statistics of one generation, from separate passes over the board before and after it
+ */
+template <class T>
+void expected_stats(const vector<bool>& before, const Life<T, LifeStats>& l, int h, int w, LifeStats& expected) {
+	expected.clear();
+	for (int x = 0; x < h; x++)
+		for (int y = 0; y < w; y++)
+			expected.count(x, y, before[x * w + y], l.at(x, y));
+}
+
+template <class T>
+void stats_match(const string& board, int h, int w, int tile, int threads, int generations) {
+	istringstream in(board);
+	Life<T, LifeStats> l(in, h, w);
+	l.set_tracking(tile);
+	l.set_threads(threads);
+
+	for (int i = 0; i < generations; i++) {
+		vector<bool> before(h * w);
+		for (int x = 0; x < h; x++)
+			for (int y = 0; y < w; y++)
+				before[x * w + y] = static_cast<const Life<T, LifeStats>&>(l).at(x, y).is_alive();
+
+		l.evolve_all();
+
+		LifeStats expected;
+		expected_stats(before, l, h, w, expected);
+		const LifeStats& actual = l.stats();
+		ASSERT_EQ(actual.births, expected.births) << "generation " << i;
+		ASSERT_EQ(actual.deaths, expected.deaths) << "generation " << i;
+		ASSERT_EQ(actual.top, expected.top) << "generation " << i;
+		ASSERT_EQ(actual.left, expected.left) << "generation " << i;
+		ASSERT_EQ(actual.bottom, expected.bottom) << "generation " << i;
+		ASSERT_EQ(actual.right, expected.right) << "generation " << i;
+		for (int a = 0; a < LifeStats::age_buckets; a++)
+			ASSERT_EQ(actual.ages[a], expected.ages[a]) << "generation " << i << ", age " << a;
+	}
+}
+
+TEST(StatsFixture, stats_blinker1) {
+	istringstream in(".....\n..*..\n..*..\n..*..\n.....\n\n");
+
+	Life<ConwayCell, LifeStats> l(in, 5, 5);
+	ASSERT_TRUE(l.stats().empty());
+	l.evolve_all();
+
+	const LifeStats& s = l.stats();
+	ASSERT_EQ(s.births, 2);
+	ASSERT_EQ(s.deaths, 2);
+	ASSERT_EQ(s.top, 2);
+	ASSERT_EQ(s.bottom, 2);
+	ASSERT_EQ(s.left, 1);
+	ASSERT_EQ(s.right, 3);
+	ASSERT_FALSE(s.empty());
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1, Population = 3.\n.....\n.....\n.***.\n.....\n.....\n\n");
+}
+
+TEST(StatsFixture, stats_ages1) {
+	istringstream in("---\n-0-\n---\n\n");
+
+	Life<FredkinCell, LifeStats> l(in, 3, 3);
+	l.evolve_all();
+
+	const LifeStats& s = l.stats();
+	ASSERT_EQ(s.births, 4);
+	ASSERT_EQ(s.deaths, 1);
+	ASSERT_EQ(s.ages[0], 4);
+	ASSERT_EQ(s.top, 0);
+	ASSERT_EQ(s.bottom, 2);
+}
+
+TEST(StatsFixture, stats_conway1) {
+	stats_match<ConwayCell>(random_board(37, 41, 137, "*."), 37, 41, 0, 1, 30);
+	stats_match<ConwayCell>(random_board(37, 41, 137, "*."), 37, 41, 0, 3, 30);
+	stats_match<ConwayCell>(random_board(37, 41, 137, "*."), 37, 41, 8, 2, 30);
+}
+
+TEST(StatsFixture, stats_fredkin1) {
+	stats_match<FredkinCell>(random_board(19, 23, 139, "0-"), 19, 23, 0, 1, 20);
+	stats_match<FredkinCell>(random_board(19, 23, 139, "0-"), 19, 23, 4, 1, 20);
+}
+
+TEST(StatsFixture, stats_cell1) {
+	stats_match<Cell>(random_board(13, 17, 149, "*.-0"), 13, 17, 0, 2, 15);
+	stats_match<MixedCell>(random_board(13, 17, 149, "*.-0"), 13, 17, 0, 1, 15);
+}
+
+// ------------
+// RuleCellTest
+// ------------
+
+TEST(RuleCellFixture, rule_mask1) {
+	static_assert(rule_mask("23") == 12, "rule_mask is a constant expression");
+	static_assert(rule_mask("") == 0, "rule_mask is a constant expression");
+	static_assert(HighLifeRule::next(false, 6) && !ConwayRule::next(false, 6), "next is a constant expression");
+	ASSERT_EQ(rule_mask("3678"), 0x1c8u);
+	ASSERT_EQ(sizeof(ConwayRule), 2u);
+	ASSERT_FALSE(std::is_polymorphic<ConwayRule>::value);
+}
+
+TEST(RuleCellFixture, rule_cell1) {
+	ConwayRule c('*');
+	const ConwayRule neighbors[8] = {'*', '*', '.', '.', '.', '.', '.', '.'};
+	ASSERT_TRUE((c + neighbors).is_alive());
+	ASSERT_FALSE((ConwayRule('.') + neighbors).is_alive());
+	ASSERT_FALSE((c + 4).is_alive());
+	ASSERT_EQ(ConwayRule(true), ConwayRule(true));
+	ASSERT_FALSE(ConwayRule(true) == ConwayRule('.'));
+
+	// the von Neumann neighborhood only looks at the first 4
+	const FredkinRule corners[8] = {'.', '.', '.', '.', '*', '*', '*', '*'};
+	ASSERT_FALSE((FredkinRule('.') + corners).is_alive());
+}
+
+TEST(RuleCellFixture, rule_conway1) {
+	// B3/S23 is Conway's rule, both run the same board the same way
+	const string board = random_board(37, 41, 151, "*.");
+	ASSERT_EQ(evolve_threads<ConwayRule>(board, 37, 41, 1, 30), evolve_threads<ConwayCell>(board, 37, 41, 1, 30));
+	ASSERT_EQ(evolve_threads<ConwayRule>(board, 37, 41, 3, 30), evolve_threads<ConwayCell>(board, 37, 41, 1, 30));
+	ASSERT_EQ(evolve_tracked<ConwayRule>(board, 37, 41, 8, 2, 30), evolve_threads<ConwayCell>(board, 37, 41, 1, 30));
+}
+
+TEST(RuleCellFixture, rule_fredkin1) {
+	// B13/S13 on the 4 neighbors is Fredkin's rule without the ages
+	const string board = random_board(19, 23, 157, "*.");
+	string fredkin = board;
+	for (char& c : fredkin)
+		if (c != '\n')
+			c = (c == '*') ? '0' : '-';
+
+	istringstream in1(board);
+	istringstream in2(fredkin);
+	Life<FredkinRule> l1(in1, 19, 23);
+	Life<FredkinCell> l2(in2, 19, 23);
+	for (int i = 0; i < 20; i++) {
+		l1.evolve_all();
+		l2.evolve_all();
+		for (int x = 0; x < 19; x++)
+			for (int y = 0; y < 23; y++)
+				ASSERT_EQ(l1.at(x, y).is_alive(), l2.at(x, y).is_alive());
+	}
+}
+
+TEST(RuleCellFixture, rule_highlife1) {
+	// 6 neighbors give birth in HighLife but not in Conway's rule
+	const string board = "***\n*.*\n*..\n\n";
+	istringstream in1(board);
+	istringstream in2(board);
+	Life<HighLifeRule> l1(in1, 3, 3);
+	Life<ConwayRule> l2(in2, 3, 3);
+	l1.evolve_all();
+	l2.evolve_all();
+	ASSERT_TRUE(l1.at(1, 1).is_alive());
+	ASSERT_FALSE(l2.at(1, 1).is_alive());
+}
+
+TEST(RuleCellFixture, rule_seeds1) {
+	// every live cell dies, every dead cell with 2 live neighbors is born
+	istringstream in("....\n.**.\n....\n\n");
+	Life<SeedsRule> l(in, 3, 4);
+	l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 1, Population = 4.\n.**.\n....\n.**.\n\n");
+}
+
+TEST(RuleCellFixture, rule_checkpoint1) {
+	checkpoint_round_trip<DayAndNightRule>(random_board(16, 16, 163, "*."), 16, 16, 10);
+}
+
+TEST(RuleCellFixture, rule_checkpoint2) {
+	// a checkpoint of one rule is not restored as another, of the same kind and bits
+	istringstream in(random_board(8, 8, 167, "*."));
+	Life<HighLifeRule> l(in, 8, 8);
+	stringstream checkpoint;
+	l.save(checkpoint);
+	const string bytes = checkpoint.str();
+
+	ASSERT_THROW(Life<ConwayRule> c(bytes.data(), bytes.size()), runtime_error);
+	ASSERT_THROW(Life<DayAndNightRule> d(bytes.data(), bytes.size()), runtime_error);
+	ASSERT_THROW(Life<FredkinRule> f(bytes.data(), bytes.size()), runtime_error);
+	ASSERT_NO_THROW(Life<HighLifeRule> h(bytes.data(), bytes.size()));
+}
+
+// ------------
+// BoundaryTest
+// ------------
+
+template <class T>
+void torus_matches(const string& board, int h, int w, int tile, int threads, int generations) {
+	// for fewer generations than the sides, a torus is the middle of 3 x 3 copies of itself
+	vector<string> rows;
+	istringstream lines(board);
+	for (string row; getline(lines, row) && !row.empty();)
+		rows.push_back(row);
+
+	string tiled;
+	for (int x = 0; x < 3 * h; x++)
+		tiled += rows[x % h] + rows[x % h] + rows[x % h] + "\n";
+	tiled += "\n";
+
+	istringstream in1(board);
+	istringstream in2(tiled);
+	Life<T, NoStats, TorusBoundary> l1(in1, h, w);
+	Life<T> l2(in2, 3 * h, 3 * w);
+	l1.set_tracking(tile);
+	l1.set_threads(threads);
+
+	for (int i = 0; i < generations; i++) {
+		l1.evolve_all();
+		l2.evolve_all();
+		for (int x = 0; x < h; x++)
+			for (int y = 0; y < w; y++)
+				ASSERT_EQ(l1.at(x, y).symbol(), l2.at(x + h, y + w).symbol()) << i << " " << x << " " << y;
+	}
+}
+
+template <class T>
+void grow_matches(const string& board, int h, int w, char dead, int generations) {
+	// nothing gets further than one cell a generation, a board that much bigger is unbounded
+	const int m = generations + 1;
+	string padded;
+	for (int x = 0; x < h + 2 * m; x++) {
+		if (x < m || x >= h + m)
+			padded += string(w + 2 * m, dead);
+		else
+			padded += string(m, dead) + board.substr((x - m) * (w + 1), w) + string(m, dead);
+		padded += "\n";
+	}
+	padded += "\n";
+
+	istringstream in1(board);
+	istringstream in2(padded);
+	Life<T, NoStats, GrowBoundary> l1(in1, h, w);
+	Life<T> l2(in2, h + 2 * m, w + 2 * m);
+
+	for (int i = 0; i < generations; i++) {
+		l1.evolve_all();
+		l2.evolve_all();
+	}
+
+	int live = 0;
+	for (int x = 0; x < l1.rows(); x++)
+		for (int y = 0; y < l1.cols(); y++) {
+			const int bx = x - l1.origin_row() + m;
+			const int by = y - l1.origin_col() + m;
+			if (bx >= 0 && by >= 0 && bx < h + 2 * m && by < w + 2 * m)
+				ASSERT_EQ(l1.at(x, y).symbol(), l2.at(bx, by).symbol());
+			else
+				ASSERT_FALSE(l1.at(x, y).is_alive());
+			live += l1.at(x, y).is_alive();
+		}
+	ostringstream out;
+	l2.print(out);
+	ASSERT_NE(out.str().find("Population = " + to_string(live) + "."), string::npos);
+}
+
+TEST(BoundaryFixture, torus_glider1) {
+	// a glider moves one cell diagonally every 4 generations, around an 8 x 8 torus in 32
+	const string board = ".*......\n..*.....\n***.....\n........\n........\n........\n........\n........\n\n";
+	istringstream in(board);
+	Life<ConwayCell, NoStats, TorusBoundary> l(in, 8, 8);
+	for (int i = 0; i < 32; i++)
+		l.evolve_all();
+
+	ostringstream out;
+	l.print(out);
+	ASSERT_EQ(out.str(), "Generation = 32, Population = 5.\n" + board);
+}
+
+TEST(BoundaryFixture, torus_conway1) {
+	const string board = random_board(15, 17, 167, "*.");
+	torus_matches<ConwayCell>(board, 15, 17, 0, 1, 14);
+	torus_matches<ConwayCell>(board, 15, 17, 0, 3, 14);
+	torus_matches<ConwayCell>(board, 15, 17, 4, 2, 14);
+}
+
+TEST(BoundaryFixture, torus_cell1) {
+	torus_matches<FredkinCell>(random_board(12, 10, 173, "0-"), 12, 10, 0, 1, 9);
+	torus_matches<Cell>(random_board(12, 10, 179, "*.-0"), 12, 10, 0, 2, 9);
+}
+
+TEST(BoundaryFixture, grow_glider1) {
+	// a glider crosses the edge of its 5 x 5 board many times over
+	istringstream in(".*...\n..*..\n***..\n.....\n.....\n\n");
+	Life<ConwayCell, NoStats, GrowBoundary> l(in, 5, 5);
+	for (int i = 0; i < 200; i++)
+		l.evolve_all();
+
+	int live = 0;
+	for (Life<ConwayCell, NoStats, GrowBoundary>::iterator<ConwayCell> b = l.begin(); b != l.end(); ++b)
+		live += (*b).is_alive();
+	ASSERT_EQ(live, 5);
+	ASSERT_GE(l.rows(), 55);
+	ASSERT_GE(l.cols(), 55);
+	// it starts on the top and left edges, the board grows there once and never again
+	ASSERT_EQ(l.origin_row(), 8);
+	ASSERT_EQ(l.origin_col(), 8);
+}
+
+TEST(BoundaryFixture, grow_conway1) {
+	grow_matches<ConwayCell>(random_board(10, 12, 181, "*."), 10, 12, '.', 40);
+	grow_matches<ConwayCell>(".....\n..*..\n..*..\n..*..\n.....\n\n", 5, 5, '.', 10);
+}
+
+TEST(BoundaryFixture, grow_cell1) {
+	grow_matches<FredkinCell>(random_board(6, 6, 191, "0-"), 6, 6, '-', 20);
+	grow_matches<Cell>(random_board(6, 7, 193, "*.-0"), 6, 7, '.', 20);
+}
+
+// ------------
+// DistLifeTest
+// ------------
+
+template <class T>
+void dist_matches(const string& board, int h, int w, int ranks, int generations) {
+	// every rank is a thread of one LocalWorld, rank 0 prints
+	LocalWorld world(ranks);
+	ostringstream out;
+	vector<thread> threads;
+	for (int r = 0; r < ranks; r++)
+		threads.push_back(thread([&world, &board, &out, h, w, r, generations] {
+			LocalComm comm(world, r);
+			DistLife<T, LocalComm> l(comm, board.data(), board.size(), h, w);
+			ostringstream mine;
+			l.print(mine);
+			for (int i = 0; i < generations; i++) {
+				l.evolve_all();
+				l.print(mine);
+			}
+			if (r == 0)
+				out << mine.str();
+		}));
+	for (thread& t : threads)
+		t.join();
+
+	istringstream in(board);
+	Life<T> l(in, h, w);
+	ostringstream expected;
+	l.print(expected);
+	for (int i = 0; i < generations; i++) {
+		l.evolve_all();
+		l.print(expected);
+	}
+	ASSERT_EQ(out.str(), expected.str());
+}
+
+TEST(DistLifeFixture, dist_grid1) {
+	int rows;
+	int cols;
+	DistLife<ConwayCell, LocalComm>::grid(4, 100, 100, rows, cols);
+	ASSERT_EQ(rows, 2);
+	ASSERT_EQ(cols, 2);
+	DistLife<ConwayCell, LocalComm>::grid(6, 100, 10, rows, cols);
+	ASSERT_EQ(rows, 6);
+	ASSERT_EQ(cols, 1);
+	// a block needs a row and a column of its own
+	DistLife<ConwayCell, LocalComm>::grid(6, 2, 3, rows, cols);
+	ASSERT_EQ(rows, 2);
+	ASSERT_EQ(cols, 3);
+}
+
+TEST(DistLifeFixture, local_comm1) {
+	LocalWorld world(3);
+	vector<long long> sums(3);
+	vector<vector<char> > gathered;
+	vector<thread> threads;
+	for (int r = 0; r < 3; r++)
+		threads.push_back(thread([&world, &sums, &gathered, r] {
+			LocalComm comm(world, r);
+			sums[r] = comm.allreduce_sum(r + 1);
+
+			// a ring, everyone receives from the rank before it
+			char in = 0;
+			const char mine = 'a' + r;
+			LocalComm::Request receive = comm.irecv(&in, 1, (r + 2) % 3, 7);
+			LocalComm::Request send = comm.isend(&mine, 1, (r + 1) % 3, 7);
+			comm.wait(send);
+			comm.wait(receive);
+
+			vector<vector<char> > all;
+			comm.gather(vector<char>(r + 1, in), all);
+			if (r == 0)
+				gathered = all;
+		}));
+	for (thread& t : threads)
+		t.join();
+
+	ASSERT_EQ(sums, vector<long long>({6, 6, 6}));
+	ASSERT_EQ(gathered.size(), 3u);
+	ASSERT_EQ(string(gathered[0].begin(), gathered[0].end()), "c");
+	ASSERT_EQ(string(gathered[1].begin(), gathered[1].end()), "aa");
+	ASSERT_EQ(string(gathered[2].begin(), gathered[2].end()), "bbb");
+}
+
+TEST(DistLifeFixture, dist_conway1) {
+	const string board = random_board(23, 31, 197, "*.");
+	dist_matches<ConwayCell>(board, 23, 31, 1, 20);
+	dist_matches<ConwayCell>(board, 23, 31, 2, 20);
+	dist_matches<ConwayCell>(board, 23, 31, 4, 20);
+	dist_matches<ConwayCell>(board, 23, 31, 6, 20);
+}
+
+TEST(DistLifeFixture, dist_conway2) {
+	// blocks of 1 and 2 rows, every cell is an edge
+	dist_matches<ConwayCell>(random_board(5, 9, 199, "*."), 5, 9, 5, 10);
+	dist_matches<ConwayCell>(random_board(4, 4, 211, "*."), 4, 4, 4, 10);
+}
+
+TEST(DistLifeFixture, dist_fredkin1) {
+	dist_matches<FredkinCell>(random_board(17, 19, 223, "0-"), 17, 19, 4, 15);
+	dist_matches<FredkinCell>(random_board(17, 19, 227, "0-"), 17, 19, 3, 15);
+}
+
+// --------------
+// DeviceLifeTest
+// --------------
+
+template <class T>
+void device_matches(const string& glyphs, int n, int h, int w, int generations) {
+	string boards;
+	for (int b = 0; b < n; b++)
+		boards += random_board(h, w, 229 + b, glyphs);
+
+	istringstream in1(boards);
+	DeviceLife<T> batch(in1, n, h, w);
+	ASSERT_EQ(batch.size(), n);
+
+	istringstream in2(boards);
+	vector<Life<T> > lives;
+	for (int b = 0; b < n; b++)
+		lives.push_back(Life<T>(in2, h, w));
+
+	for (int i = 0; i <= generations; i++) {
+		for (int b = 0; b < n; b++) {
+			ostringstream out1;
+			ostringstream out2;
+			batch.print(b, out1);
+			lives[b].print(out2);
+			ASSERT_EQ(out1.str(), out2.str());
+		}
+		batch.evolve_all();
+		for (Life<T>& l : lives)
+			l.evolve_all();
+	}
+}
+
+TEST(DeviceLifeFixture, device_conway1) {
+	// boards that are not a whole number of tiles
+	device_matches<ConwayCell>("*.", 5, 37, 41, 20);
+	device_matches<ConwayCell>("*.", 3, 16, 16, 10);
+}
+
+TEST(DeviceLifeFixture, device_fredkin1) {
+	device_matches<FredkinCell>("0-", 4, 19, 23, 20);
+}
+
+TEST(DeviceLifeFixture, device_at1) {
+	istringstream in("...\n***\n...\n\n.*.\n.*.\n.*.\n\n");
+	DeviceLife<ConwayCell> batch(in, 2, 3, 3);
+	batch.evolve(3);
+	ASSERT_EQ(batch.generation(), 3);
+	ASSERT_TRUE(batch.at(0, 0, 1).is_alive());
+	ASSERT_FALSE(batch.at(0, 1, 0).is_alive());
+	ASSERT_TRUE(batch.at(1, 1, 0).is_alive());
+	ASSERT_EQ(batch.population(0), 3);
+	ASSERT_EQ(batch.population(1), 3);
+}
+
+// -------------
+// LifeBatchTest
+// -------------
+
+string run_batch(const string& input, int threads) {
+	istringstream in(input);
+	LifeBatch batch(in);
+	ostringstream out;
+	batch.run(out, threads);
+	return out.str();
+}
+
+TEST(LifeBatchFixture, batch_run1) {
+	const string input = "ConwayCell 3 3 0-2\n...\n***\n...\n\nFredkinCell 1 3 1\n-0-\n\n";
+	ASSERT_EQ(run_batch(input, 1),
+		"*** Life<ConwayCell> 3x3 ***\n\n"
+		"Generation = 0, Population = 3.\n...\n***\n...\n\n"
+		"Generation = 1, Population = 3.\n.*.\n.*.\n.*.\n\n"
+		"Generation = 2, Population = 3.\n...\n***\n...\n\n"
+		"*** Life<FredkinCell> 1x3 ***\n\n"
+		"Generation = 1, Population = 2.\n0-0\n\n");
+}
+
+TEST(LifeBatchFixture, batch_range1) {
+	// a range is walked, not expanded, and its last generation is the last whole step
+	ASSERT_EQ(run_batch("ConwayCell 1 2 0-2000000000/1000000000 2000000001-2000000010/7\n*.\n\n", 1),
+		"*** Life<ConwayCell> 1x2 ***\n\n"
+		"Generation = 0, Population = 1.\n*.\n\n"
+		"Generation = 1000000000, Population = 0.\n..\n\n"
+		"Generation = 2000000000, Population = 0.\n..\n\n"
+		"Generation = 2000000001, Population = 0.\n..\n\n"
+		"Generation = 2000000008, Population = 0.\n..\n\n");
+}
+
+TEST(LifeBatchFixture, batch_order1) {
+	// boards of very different sizes and lengths come out in input order with any number of workers
+	string input;
+	for (int b = 0; b < 40; b++) {
+		const int h = 3 + (b * 7) % 31;
+		const int w = 4 + (b * 11) % 37;
+		input += (b % 3 == 0 ? "FredkinCell " : b % 3 == 1 ? "ConwayCell " : "Cell ") + to_string(h) + " " + to_string(w) +
+		         " 0 " + to_string(1 + b % 5) + "-" + to_string(10 + (b * 13) % 50) + "/3\n";
+		input += random_board(h, w, 233 + b, b % 3 == 0 ? "0-" : b % 3 == 1 ? "*." : "*.-0");
+	}
+
+	const string expected = run_batch(input, 1);
+	ASSERT_EQ(run_batch(input, 2), expected);
+	ASSERT_EQ(run_batch(input, 5), expected);
+}
+
+TEST(LifeBatchFixture, batch_errors1) {
+	ASSERT_THROW(run_batch("MixedCell 1 1 0\n.\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 2 2 0\n..\n.\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 1 2 0\n...\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 1 1 3 2\n.\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 1 1 3-x\n.\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 1 1 0-9/3 9\n.\n\n", 1), runtime_error);
+	// generations past INT_MAX
+	ASSERT_THROW(run_batch("ConwayCell 3 3 4294967297\n...\n...\n...\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 1 1 0-99999999999999999999\n.\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("ConwayCell 1 1 0-10/4294967297\n.\n\n", 1), runtime_error);
+	// glyphs of another cell
+	ASSERT_THROW(run_batch("ConwayCell 1 3 0\n-*.\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("FredkinCell 1 3 0\n-*0\n\n", 1), runtime_error);
+	ASSERT_THROW(run_batch("Cell 1 3 0\n-x0\n\n", 1), runtime_error);
+	ASSERT_EQ(run_batch("\n\n", 3), "");
+}
+
+// ------------
+// SnapshotTest
+// ------------
+
+/**
+ * a streambuf that takes 20ms for every write, slower than any board of the tests evolves
+ */
+class SlowBuffer : public std::stringbuf {
+protected:
+	std::streamsize xsputn(const char* s, std::streamsize n) {
+		usleep(20000);
+		return std::stringbuf::xsputn(s, n);
+	}
+};
+
+template <class T>
+void snapshot_matches(const string& board, int h, int w, const SnapshotSchedule& schedule, int depth) {
+	istringstream in1(board);
+	Life<T> l1(in1, h, w);
+	ostringstream out1;
+	for (int i = 0; i <= schedule.generations().back(); i++) {
+		if (schedule.contains(i))
+			l1.print(out1);
+		l1.evolve_all();
+	}
+
+	istringstream in2(board);
+	Life<T> l2(in2, h, w);
+	ostringstream out2;
+	{
+		SnapshotWriter<T> writer(out2, depth);
+		writer.run(l2, schedule);
+	}
+	ASSERT_EQ(out2.str(), out1.str());
+}
+
+TEST(SnapshotFixture, snapshot_print1) {
+	istringstream in("-0--\n0-00\n");
+	Life<FredkinCell> l(in, 2, 4);
+	l.evolve_all();
+	Snapshot<FredkinCell> s;
+	l.snapshot(s);
+	ASSERT_EQ(s.generation, 1);
+	ASSERT_EQ(s.height, 2);
+	ASSERT_EQ(s.width, 4);
+	ASSERT_EQ(s.cells.size(), 8u);
+
+	ostringstream out1;
+	ostringstream out2;
+	l.print(out1);
+	s.print(out2);
+	ASSERT_EQ(out2.str(), out1.str());
+}
+
+TEST(SnapshotFixture, snapshot_schedule1) {
+	const SnapshotSchedule every = SnapshotSchedule::every(4, 30);
+	ASSERT_EQ(every.generations(), vector<int>({0, 4, 8, 12, 16, 20, 24, 28}));
+	ASSERT_EQ(every.next(5), 8);
+	ASSERT_EQ(every.next(29), -1);
+	ASSERT_TRUE(every.contains(28));
+	ASSERT_FALSE(every.contains(2));
+
+	const SnapshotSchedule at = SnapshotSchedule::at({2500, 283, 323, 283});
+	ASSERT_EQ(at.generations(), vector<int>({283, 323, 2500}));
+	ASSERT_EQ(at.next(0), 283);
+	ASSERT_EQ(at.next(324), 2500);
+}
+
+TEST(SnapshotFixture, snapshot_writer1) {
+	snapshot_matches<ConwayCell>(random_board(20, 29, 239, "*."), 20, 29, SnapshotSchedule::every(4, 28), 4);
+	snapshot_matches<FredkinCell>(random_board(20, 20, 241, "0-"), 20, 20, SnapshotSchedule::every(1, 5), 2);
+	snapshot_matches<Cell>(random_board(20, 20, 243, "*.-0"), 20, 20, SnapshotSchedule::every(1, 5), 1);
+}
+
+TEST(SnapshotFixture, snapshot_writer2) {
+	snapshot_matches<ConwayCell>(random_board(109, 69, 247, "*."), 109, 69, SnapshotSchedule::at({283, 323, 2500}), 4);
+}
+
+TEST(SnapshotFixture, snapshot_backpressure1) {
+	// with one snapshot and a slow stream every push after the first waits for the writer
+	istringstream in("...\n***\n...\n");
+	Life<ConwayCell> l(in, 3, 3);
+	SlowBuffer buffer;
+	ostream out(&buffer);
+	SnapshotWriter<ConwayCell> writer(out, 1);
+	writer.run(l, SnapshotSchedule::every(1, 3));
+	writer.flush();
+	ASSERT_EQ(writer.written(), 4);
+	ASSERT_EQ(writer.waits(), 3);
+	ASSERT_EQ(buffer.str().substr(0, 32), "Generation = 0, Population = 3.\n");
+}
+
+// ---------
+// ProbeTest
+// ---------
+
+typedef Life<ConwayCell, NoStats, DeadBoundary, LifeProbe> ProbedLife;
+
+TEST(ProbeFixture, probe_events1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+	ProbedLife l(in, 3, 3);
+	l.evolve_all();
+	l.evolve_all();
+	ostringstream out;
+	l.print(out);
+
+	const vector<ProbeEvent>& events = l.probe().events();
+	ASSERT_EQ(events.size(), 4u);
+	ASSERT_EQ(events[0].kind, ProbeEvent::LOAD);
+	ASSERT_EQ(events[0].cells, 9);
+	ASSERT_EQ(events[1].kind, ProbeEvent::EVOLVE);
+	ASSERT_EQ(events[1].generation, 1);
+	ASSERT_EQ(events[1].population, 3);
+	ASSERT_EQ(events[1].cells, 9);
+	ASSERT_EQ(events[1].skipped, 0);
+	ASSERT_EQ(events[3].kind, ProbeEvent::PRINT);
+	ASSERT_EQ(events[3].bytes, out.str().size());
+	ASSERT_STREQ(events[3].name(), "print");
+
+	for (const ProbeEvent& e : events) {
+		ASSERT_GE(e.duration, 0);
+		ASSERT_EQ(e.allocations, -1);
+	}
+	ASSERT_LE(events[1].start + events[1].duration, events[2].start);
+}
+
+TEST(ProbeFixture, probe_tracked1) {
+	// a blinker in one corner of a 32x32 board, tracking evolves its tiles and skips the rest
+	string board = string(33, '.');
+	board[0] = board[1] = board[2] = '*';
+	board[32] = '\n';
+	for (int x = 1; x < 32; x++)
+		board += string(32, '.') + '\n';
+	istringstream in(board + '\n');
+	ProbedLife l(in, 32, 32);
+	ASSERT_TRUE(l.set_tracking(8));
+	l.evolve_all();
+	l.evolve_all();
+
+	const ProbeEvent& e = l.probe().events().back();
+	ASSERT_EQ(e.cells, l.evolved_cells());
+	ASSERT_EQ(e.cells + e.skipped, 32 * 32);
+	ASSERT_EQ(e.cells, 4 * 8 * 8);
+}
+
+TEST(ProbeFixture, probe_callback1) {
+	const string board = random_board(20, 30, 257, "*.");
+
+	istringstream in1(board);
+	Life<ConwayCell> l1(in1, 20, 30);
+	istringstream in2(board);
+	ProbedLife l2(in2, 20, 30);
+
+	int evolves = 0;
+	long long cells = 0;
+	atomic<long long> allocations(0);
+	l2.probe().keep_events(false);
+	l2.probe().count_allocations(&allocations);
+	l2.probe().set_callback([&evolves, &cells](const ProbeEvent& e) {
+		evolves += e.kind == ProbeEvent::EVOLVE;
+		cells += e.cells;
+		ASSERT_EQ(e.allocations, 0);
+	});
+
+	ostringstream out1;
+	ostringstream out2;
+	for (int i = 0; i < 10; i++) {
+		l1.evolve_all();
+		l2.evolve_all();
+		l1.print(out1);
+		l2.print(out2);
+	}
+	ASSERT_EQ(out1.str(), out2.str());
+	ASSERT_EQ(evolves, 10);
+	ASSERT_EQ(cells, 10 * 20 * 30);
+	// only the load was kept, it came before keep_events(false)
+	ASSERT_EQ(l2.probe().events().size(), 1u);
+}
+
+TEST(ProbeFixture, probe_trace1) {
+	istringstream in(".*.\n.*.\n.*.\n\n");
+	ProbedLife l(in, 3, 3);
+	l.evolve_all();
+	ostringstream out;
+	l.print(out);
+
+	ostringstream trace;
+	l.probe().write_trace(trace);
+	const string s = trace.str();
+	ASSERT_EQ(s.find("{\"traceEvents\":["), 0u);
+	ASSERT_NE(s.find("{\"name\":\"load\",\"cat\":\"life\",\"ph\":\"X\""), string::npos);
+	ASSERT_NE(s.find("\"args\":{\"generation\":1,\"population\":3,\"cells\":9,\"skipped\":0}"), string::npos);
+	ASSERT_NE(s.find("\"args\":{\"generation\":1,\"population\":3,\"bytes\":" + to_string(out.str().size()) + "}"), string::npos);
+	ASSERT_NE(s.find("\"ph\":\"C\""), string::npos);
+	ASSERT_EQ(s.substr(s.size() - 27), "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+// -----------
+// LutLifeTest
+// -----------
+
+// the table is checked at compile time, from the rule itself
+static_assert(LutLife<>::block(0) == 0, "an empty square stays empty");
+static_assert(LutLife<>::block(0x0e00) == 0xa, "the middle of a row of three survives, the cell below it is born");
+static_assert(LutLife<>::block(0x0660) == 0xf, "a block is still");
+
+template <class Rule>
+void lut_matches(const string& board, int h, int w, int generations) {
+	istringstream in1(board);
+	istringstream in2(board);
+	Life<Rule> l1(in1, h, w);
+	LutLife<Rule> l2(in2, h, w);
+
+	for (int i = 0; i <= generations; i++) {
+		ostringstream out1;
+		ostringstream out2;
+		l1.print(out1);
+		l2.print(out2);
+		ASSERT_EQ(out1.str(), out2.str()) << "generation " << i;
+		ASSERT_EQ(l1.population(), l2.population());
+
+		l1.evolve_all();
+		l2.evolve_all();
+	}
+}
+
+TEST(LutLifeFixture, lut_conway1) {
+	// odd and even heights and widths, the padding row and column stay dead
+	lut_matches<ConwayRule>(random_board(20, 29, 269, "*."), 20, 29, 40);
+	lut_matches<ConwayRule>(random_board(21, 13, 271, "*."), 21, 13, 40);
+	lut_matches<ConwayRule>(random_board(1, 1, 277, "*."), 1, 1, 2);
+}
+
+TEST(LutLifeFixture, lut_rules1) {
+	lut_matches<HighLifeRule>(random_board(33, 34, 281, "*."), 33, 34, 30);
+	lut_matches<DayAndNightRule>(random_board(17, 18, 283, "*."), 17, 18, 30);
+	lut_matches<FredkinRule>(random_board(19, 23, 293, "*."), 19, 23, 30);
+}
+
+TEST(LutLifeFixture, lut_at1) {
+	istringstream in(".....\n..*..\n..*..\n..*..\n.....\n\n");
+	LutLife<> l(in, 5, 5);
+	l.evolve(3);
+	ASSERT_EQ(l.generation(), 3);
+	ASSERT_EQ(l.population(), 3);
+	ASSERT_TRUE(l.at(2, 1).is_alive());
+	ASSERT_TRUE(l.at(2, 3).is_alive());
+	ASSERT_FALSE(l.at(1, 2).is_alive());
+}
+
+// -------------
+// LifeCacheTest
+// -------------
+
+TEST(LifeCacheFixture, cache_resume1) {
+	const string board = random_board(20, 29, 307, "*.");
+	LifeCache<ConwayCell> cache(16);
+
+	LifeCache<ConwayCell>::cursor c1 = cache.open(board.data(), board.size(), 20, 29);
+	c1.evolve_to(100);
+	ASSERT_EQ(cache.reused(), 0);
+
+	// the same text again, read from a stream this time, starts from the checkpoint of generation 80
+	istringstream in(board);
+	LifeCache<ConwayCell>::cursor c2 = cache.open(in, 20, 29);
+	ASSERT_EQ(cache.size(), 1);
+	c2.evolve_to(90);
+	ASSERT_EQ(cache.reused(), 80);
+
+	istringstream in1(board);
+	Life<ConwayCell> l(in1, 20, 29);
+	l.evolve_n(90);
+	ostringstream out1;
+	ostringstream out2;
+	l.print(out1);
+	c2.print(out2);
+	ASSERT_EQ(out1.str(), out2.str());
+	ASSERT_EQ(c2.generation(), 90);
+}
+
+TEST(LifeCacheFixture, cache_population1) {
+	const string board = random_board(17, 19, 311, "0-");
+	LifeCache<FredkinCell> cache(8);
+	LifeCache<FredkinCell>::cursor c = cache.open(board.data(), board.size(), 17, 19);
+	c.evolve_to(30);
+
+	istringstream in(board);
+	Life<FredkinCell> l(in, 17, 19);
+	for (int g = 0; g <= 30; g++) {
+		ASSERT_EQ(c.population_at(g), l.population()) << "generation " << g;
+		l.evolve_all();
+	}
+	ASSERT_EQ(c.population_at(31), -1);
+	ASSERT_EQ(cache.checkpoint_bytes(), 3 * Life<FredkinCell>::checkpoint_size(17, 19));
+}
+
+TEST(LifeCacheFixture, cache_schedule1) {
+	// a board printed on two schedules, the second run reuses the first
+	const string board = random_board(109, 69, 313, "*.");
+	LifeCache<ConwayCell> cache(16);
+
+	string outputs[2];
+	for (int run = 0; run < 2; run++) {
+		LifeCache<ConwayCell>::cursor c = cache.open(board.data(), board.size(), 109, 69);
+		ostringstream out;
+		for (int g : {28, 100, 250}) {
+			c.evolve_to(g);
+			c.print(out);
+		}
+		outputs[run] = out.str();
+	}
+	ASSERT_EQ(outputs[0], outputs[1]);
+	// from 0 to the checkpoint of 16, from 28 to 96 and from 100 to 240
+	ASSERT_EQ(cache.reused(), 16 + 68 + 140);
+}
+
+TEST(LifeCacheFixture, cache_distinct1) {
+	LifeCache<ConwayCell> cache;
+	cache.open(".*.\n.*.\n.*.\n", 12, 3, 3);
+	cache.open("...\n***\n...\n", 12, 3, 3);
+	cache.open(".*.*.*\n", 7, 1, 6);
+	cache.open(".*.\n.*.\n.*.\n", 12, 3, 3);
+	ASSERT_EQ(cache.size(), 3);
+
+	LifeCache<ConwayCell>::cursor c = cache.open("...\n***\n...\n", 12, 3, 3);
+	c.evolve_all();
+	ASSERT_TRUE(c.life().at(0, 1).is_alive());
+	ASSERT_EQ(c.population(), 3);
+}
+
+// --------------
+// StreamLifeTest
+// --------------
+
+TEST(StreamLifeFixture, stream_conway1) {
+	// every row written is the row Life<T> prints, after the header
+	const string board = random_board(53, 37, 331, "*.");
+	for (int k : {0, 1, 2, 7}) {
+		istringstream in(board);
+		ostringstream out;
+		StreamLife<ConwayCell> s(53, 37, k);
+		const int population = s.run(in, out);
+
+		istringstream l_in(board);
+		Life<ConwayCell> l(l_in, 53, 37);
+		l.evolve_n(k);
+		ostringstream l_out;
+		l.print(l_out);
+
+		const string expected = l_out.str();
+		ASSERT_EQ(out.str(), expected.substr(expected.find('\n') + 1)) << k << " generations";
+		ASSERT_EQ(population, l.population());
+		ASSERT_EQ(s.population(), l.population());
+	}
+}
+
+TEST(StreamLifeFixture, stream_fredkin1) {
+	const string board = random_board(29, 41, 337, "0-");
+	istringstream in(board);
+	ostringstream out;
+	StreamLife<FredkinCell> s(29, 41, 5);
+	s.run(in, out);
+
+	istringstream l_in(board);
+	Life<FredkinCell> l(l_in, 29, 41);
+	l.evolve_n(5);
+	ostringstream l_out;
+	l.print(l_out);
+
+	const string expected = l_out.str();
+	ASSERT_EQ(out.str(), expected.substr(expected.find('\n') + 1));
+	ASSERT_EQ(s.generation(), 5);
+}
+
+TEST(StreamLifeFixture, stream_cell1) {
+	// Cell is given its neighbors, the rows of a window are not next to each other
+	const string board = random_board(23, 19, 347, "*.0-");
+	istringstream in(board);
+	ostringstream out;
+	StreamLife<Cell> s(23, 19, 4);
+	s.run(in, out);
+
+	istringstream l_in(board);
+	Life<Cell> l(l_in, 23, 19);
+	l.evolve_n(4);
+	ostringstream l_out;
+	l.print(l_out);
+
+	const string expected = l_out.str();
+	ASSERT_EQ(out.str(), expected.substr(expected.find('\n') + 1));
+	ASSERT_EQ(s.population(), l.population());
+}
+
+TEST(StreamLifeFixture, stream_window1) {
+	// more generations than rows, and the next board of the stream is left unread
+	istringstream in("...\n***\n...\n\n.*.\n");
+	ostringstream out;
+	StreamLife<ConwayCell> s(3, 3, 5);
+	ASSERT_EQ(s.run(in, out), 3);
+	ASSERT_EQ(out.str(), ".*.\n.*.\n.*.\n\n");
+	ASSERT_EQ(in.get(), '.');
+	// 3 rows of each of generations 0 to 5 and the dead row, whatever the height
+	ASSERT_EQ(s.window_cells(), (size_t) (3 * 6 + 1) * 5);
+	ASSERT_EQ(StreamLife<ConwayCell>(1000000, 3, 5).window_cells(), s.window_cells());
+}
@@ -0,0 +1,63 @@
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int n) : job(nullptr), round(0), pending(0), stop(false) {
+	for (int i = 1; i < n; i++)
+		threads.push_back(thread(&ThreadPool::work, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> l(lock);
+		stop = true;
+	}
+	start.notify_all();
+
+	for (thread& t : threads)
+		t.join();
+}
+
+void ThreadPool::run(const function<void(int)>& j) {
+	{
+		lock_guard<mutex> l(lock);
+		job = &j;
+		pending = threads.size();
+		round++;
+	}
+	start.notify_all();
+
+	j(0);
+
+	unique_lock<mutex> l(lock);
+	done.wait(l, [this] { return pending == 0; });
+	job = nullptr;
+}
+
+void ThreadPool::work(int i) {
+	int seen = 0;
+
+	while (true) {
+		const function<void(int)>* j;
+		{
+			unique_lock<mutex> l(lock);
+			start.wait(l, [this, seen] { return stop || round != seen; });
+			if (stop)
+				return;
+			seen = round;
+			j = job;
+		}
+
+		(*j)(i);
+
+		lock_guard<mutex> l(lock);
+		if (--pending == 0)
+			done.notify_one();
+	}
+}
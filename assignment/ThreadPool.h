@@ -0,0 +1,83 @@
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+
+// 	-----------------------------------------------------------------------
+//	Class ThreadPool keeps its worker threads alive between jobs, so a board
+//	can hand every generation to the same threads without spawning any
+// 	-----------------------------------------------------------------------
+class ThreadPool {
+public:
+
+	/**
+	 * constructor, starts n - 1 threads, the thread calling run() is worker 0
+	 * @param n the number of workers
+	 */
+	explicit ThreadPool(int n);
+
+	/**
+	 * destructor, stops and joins the threads
+	 */
+	~ThreadPool();
+
+	/**
+	 * run job(i) once on every worker i, returns when all of them are done
+	 * @param job the work of one worker, given the index of the worker
+	 */
+	void run(const std::function<void(int)>& job);
+
+	/**
+	 * how many workers does a job run on?
+	 * @return the number of workers
+	 */
+	int size() const { return threads.size() + 1; }
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+private:
+	/**
+	 * the loop of worker thread i, waits for a job, runs it, reports back
+	 * @param i the index of the worker
+	 */
+	void work(int i);
+
+	std::vector<std::thread> threads;			//workers 1 to n - 1
+	std::mutex lock;							//guards everything below
+	std::condition_variable start;				//signaled when a job is posted
+	std::condition_variable done;				//signaled when the last worker finishes
+	const std::function<void(int)>* job;		//the job being run
+	int round;									//how many jobs have been posted
+	int pending;								//threads still running the current job
+	bool stop;									//set by the destructor
+};
+
+// 	-----------------------------------------------------------------------
+//	Class ThreadPoolHandle owns a ThreadPool like a unique_ptr, but it can be
+//	copied: the copy starts a pool of its own with as many workers, so an
+//	object holding one keeps its copy operations
+// 	-----------------------------------------------------------------------
+class ThreadPoolHandle : public std::unique_ptr<ThreadPool> {
+public:
+	ThreadPoolHandle() = default;
+	ThreadPoolHandle(ThreadPoolHandle&&) = default;
+	ThreadPoolHandle& operator=(ThreadPoolHandle&&) = default;
+
+	ThreadPoolHandle(const ThreadPoolHandle& that) :
+			std::unique_ptr<ThreadPool>(that ? new ThreadPool(that->size()) : nullptr) {
+	}
+
+	ThreadPoolHandle& operator=(const ThreadPoolHandle& that) {
+		if (this != &that && (!that || !*this || (*this)->size() != that->size()))
+			reset(that ? new ThreadPool(that->size()) : nullptr);
+		return *this;
+	}
+};
+
+#endif
@@ -0,0 +1,454 @@
+#ifndef TiledLife_h
+#define TiledLife_h
+
+#include <vector>
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+#include "Life.h"
+
+// 	--------------------------------------------------------------------------
+//	Generic Class TiledLife has the same board as Life<T>, stored as square
+//	tiles of tile x tile cells. Each tile is contiguous and carries a ring of
+//	halo cells copied from the tiles around it, so a tile can be evolved on
+//	its own while it is in cache, up to halo generations before the halos
+//	have to be copied again (temporal blocking).
+// 	--------------------------------------------------------------------------
+template <class T>
+class TiledLife {
+public:
+
+	/**
+	 * constructor
+	 * @param in the istream to read from
+	 * @param h is the height of the board
+	 * @param w is the width of the board
+	 * @param tile_ the side of the tiles
+	 * @param halo_ the depth of the halo, how many generations a tile can evolve on its own, at most tile_
+	 */
+	TiledLife(std::istream& in, int h, int w, int tile_ = 64, int halo_ = 4) {
+		assert(tile_ > 0);
+		assert(halo_ > 0 && halo_ <= tile_);
+
+		width = w;
+		height = h;
+		tile = tile_;
+		halo = halo_;
+		span = tile + 2 * halo;
+		tile_rows = (height + tile - 1) / tile;
+		tile_cols = (width + tile - 1) / tile;
+		generation = 0;
+		population = 0;
+
+		board.resize(tile_rows * tile_cols * span * span, T(true)); // every cell off the board stays a border
+
+		int x = 0;
+		int y = 0;
+
+		while (true) {
+			int input = in.get();
+
+			if (input == EOF || (input == '\n' && y == 0))
+				break;
+
+			if (input == '\n') {
+				x++;
+				assert(y == width);
+				y = 0;
+				continue;
+			}
+
+			T new_cell = T((char) input);
+
+			if (new_cell.is_alive())
+				population++;
+
+			at(x, y) = std::move(new_cell);
+
+			y++;
+		}
+
+		assert(x == height);
+
+		a.resize(span * span);
+		b.resize(span * span);
+	}
+
+	/**
+	 * print the board, same format as Life<T>::print
+	 * @param out the ostream to write to
+	 */
+	void print(std::ostream& out) const {
+		out << "Generation = " << generation << ", Population = " << population << "." << std::endl;
+		for (int x = 0; x < height; x++) {
+			for (int y = 0; y < width; y++)
+				out << at(x, y);
+
+			out << std::endl;
+		}
+		out << std::endl;
+	}
+
+	/**
+	 * evolve every cell of the board one generation
+	 */
+	void evolve_all() {
+		evolve(1);
+	}
+
+	/**
+	 * evolve every cell of the board n generations, each tile evolving up to halo generations at a time
+	 * @param n the number of generations
+	 */
+	void evolve(int n) {
+		typedef std::integral_constant<bool, NeighborKernel<T>::dense> dense;
+
+		while (n > 0) {
+			const int steps = std::min(n, halo);
+
+			exchange();
+
+			population = 0;
+			for (int tx = 0; tx < tile_rows; tx++)
+				for (int ty = 0; ty < tile_cols; ty++)
+					population += evolve_tile(dense(), tx, ty, steps);
+
+			generation += steps;
+			n -= steps;
+		}
+	}
+
+	/**
+	 * will retrieve the cell at position (x, y) in the board
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @return the cell at position (x,y)
+	 */
+	T& at(int x, int y) {
+		assert(x >= 0 && x < height && y >= 0 && y < width);
+		return board[index(x, y)];
+	}
+
+	/**
+	 * const version of at(), will retrieve the cell at position (x, y) in the board
+	 * @param x the row of the cell
+	 * @param y the column of the cell
+	 * @return the cell at position (x,y)
+	 */
+	const T& at(int x, int y) const {
+		assert(x >= 0 && x < height && y >= 0 && y < width);
+		return board[index(x, y)];
+	}
+
+	// 	---------------------------------------------------
+	//	Nested Class iterator, it will iterate over the board
+	//	---------------------------------------------------
+	class iterator {
+	public:
+
+		/**
+		 * constructor
+		 * @param l is the board to iterate over
+		 * @param x_ the row to start at
+		 * @param y_ the column to start at
+		 */
+		iterator(TiledLife& l, int x_, int y_) : life(l), x(x_), y(y_) {}
+
+		/**
+		 * operator * will override the * operator for iterator
+		 * @return a reference to the cell this iterator points to
+		 */
+		T& operator*() const {
+			return life.at(x, y);
+		}
+
+		/**
+		 * operator ++ will iterate to the next cell
+		 * @return a reference to this iterator
+		 */
+		iterator& operator++() {
+			if (++y >= life.width) {
+				x++;
+				y = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator -- will iterate to the previous cell
+		 * @return a reference to this iterator
+		 */
+		iterator& operator--() {
+			if (--y < 0) {
+				x--;
+				y = life.width - 1;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator == will override the == operator for iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator==(const iterator& rhs) const {
+			return x == rhs.x && y == rhs.y && &life == &rhs.life;
+		}
+
+		/**
+		 * operator != will override the != operator for iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator!=(const iterator& rhs) const {
+			return !(*this == rhs);
+		}
+	private:
+		TiledLife& life;	//the board that will be iterated over
+		int x;				//current x
+		int y;				//current y
+	};
+
+	// 	---------------------------------------------------------
+	//	Nested Class const_iterator, it will iterate over the board
+	//	---------------------------------------------------------
+	class const_iterator {
+	public:
+
+		/**
+		 * constructor
+		 * @param l is the board to iterate over
+		 * @param x_ the row to start at
+		 * @param y_ the column to start at
+		 */
+		const_iterator(const TiledLife& l, int x_, int y_) : life(l), x(x_), y(y_) {}
+
+		/**
+		 * operator * will override the * operator for const_iterator
+		 * @return a reference to the cell this iterator points to
+		 */
+		const T& operator*() const {
+			return life.at(x, y);
+		}
+
+		/**
+		 * operator ++ will iterate to the next cell
+		 * @return a reference to this iterator
+		 */
+		const_iterator& operator++() {
+			if (++y >= life.width) {
+				x++;
+				y = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator -- will iterate to the previous cell
+		 * @return a reference to this iterator
+		 */
+		const_iterator& operator--() {
+			if (--y < 0) {
+				x--;
+				y = life.width - 1;
+			}
+			return *this;
+		}
+
+		/**
+		 * operator == will override the == operator for const_iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator==(const const_iterator& rhs) const {
+			return x == rhs.x && y == rhs.y && &life == &rhs.life;
+		}
+
+		/**
+		 * operator != will override the != operator for const_iterator
+		 * @return a bool with the value of the comparison
+		 */
+		bool operator!=(const const_iterator& rhs) const {
+			return !(*this == rhs);
+		}
+	private:
+		const TiledLife& life;	//the board that will be iterated over
+		int x;					//current x
+		int y;					//current y
+	};
+
+	/**
+	 * return the first cell in the board
+	 * @return an iterator to the first cell
+	 */
+	iterator begin() { return iterator(*this, 0, 0); }
+
+	/**
+	 * return the first cell in the board
+	 * @return an iterator to the first cell
+	 */
+	const_iterator begin() const { return const_iterator(*this, 0, 0); }
+
+	/**
+	 * return one past the last cell in the board
+	 * @return an iterator one past the last cell
+	 */
+	iterator end() { return iterator(*this, height, 0); }
+
+	/**
+	 * return one past the last cell in the board
+	 * @return an iterator one past the last cell
+	 */
+	const_iterator end() const { return const_iterator(*this, height, 0); }
+
+private:
+	/**
+	 * where the cell at (x, y) lives, inside its own tile
+	 */
+	int index(int x, int y) const {
+		const int t = (x / tile) * tile_cols + y / tile;
+		return t * span * span + (x % tile + halo) * span + y % tile + halo;
+	}
+
+	/**
+	 * copy the halo of every tile from the tiles around it, the halo cells off the board stay borders
+	 */
+	void exchange() {
+		for (int tx = 0; tx < tile_rows; tx++)
+			for (int ty = 0; ty < tile_cols; ty++) {
+				T* t = &board[(tx * tile_cols + ty) * span * span];
+
+				for (int r = 0; r < span; r++) {
+					const int x = tx * tile + r - halo;
+					if (x < 0 || x >= height)
+						continue;
+
+					// the interior rows only have a halo left and right of the tile
+					const bool inner = r >= halo && r < halo + tile;
+					for (int c = 0; c < span; c++) {
+						if (inner && c == halo)
+							c = halo + tile;
+
+						const int y = ty * tile + c - halo;
+						if (y >= 0 && y < width)
+							t[r * span + c] = board[index(x, y)];
+					}
+				}
+			}
+	}
+
+	/**
+	 * the rows and columns of tile (tx, ty), in local coordinates, that are on the board
+	 */
+	void bounds(int tx, int ty, int& r_end, int& c_end) const {
+		r_end = std::min(span, height - tx * tile + halo);
+		c_end = std::min(span, width - ty * tile + halo);
+	}
+
+	/**
+	 * write the interior of the scratch tile back into tile (tx, ty) and count its population
+	 */
+	int store(T* t, int r_end, int c_end) {
+		int live = 0;
+		for (int r = halo; r < std::min(halo + tile, r_end); r++)
+			for (int c = halo; c < std::min(halo + tile, c_end); c++) {
+				t[r * span + c] = a[r * span + c];
+				live += a[r * span + c].is_alive();
+			}
+		return live;
+	}
+
+	/**
+	 * evolve tile (tx, ty) steps generations, each cell is given a view of its 8 neighbors
+	 * the cells that are right after step s shrink by one ring every step, the interior is right after halo steps
+	 * @return the population of the tile
+	 */
+	int evolve_tile(std::false_type, int tx, int ty, int steps) {
+		T* t = &board[(tx * tile_cols + ty) * span * span];
+		int r_end;
+		int c_end;
+		bounds(tx, ty, r_end, c_end);
+		const int r_begin = std::max(0, halo - tx * tile);
+		const int c_begin = std::max(0, halo - ty * tile);
+
+		std::copy(t, t + span * span, a.begin());
+		std::copy(t, t + span * span, b.begin());
+
+		std::ptrdiff_t offsets[8];
+		Neighborhood<T>::board_offsets(span, offsets);
+
+		for (int s = 1; s <= steps; s++) {
+			for (int r = std::max(s, r_begin); r < std::min(span - s, r_end); r++)
+				for (int c = std::max(s, c_begin); c < std::min(span - s, c_end); c++) {
+					const int i = r * span + c;
+
+					const Neighborhood<T> neighbors(&a[i], offsets);
+					b[i] = a[i] + neighbors;
+				}
+			a.swap(b);
+		}
+
+		return store(t, r_end, c_end);
+	}
+
+	/**
+	 * evolve tile (tx, ty) steps generations, each cell is given its live neighbor count
+	 * the counts of a row come from NeighborKernel<T> over the alive plane of the tile
+	 * @return the population of the tile
+	 */
+	int evolve_tile(std::true_type, int tx, int ty, int steps) {
+		T* t = &board[(tx * tile_cols + ty) * span * span];
+		int r_end;
+		int c_end;
+		bounds(tx, ty, r_end, c_end);
+		const int r_begin = std::max(0, halo - tx * tile);
+		const int c_begin = std::max(0, halo - ty * tile);
+
+		std::copy(t, t + span * span, a.begin());
+		alive.assign(span * span, 0);
+		next_alive.assign(span * span, 0);
+		counts.resize(span);
+		for (int r = r_begin; r < r_end; r++)
+			for (int c = c_begin; c < c_end; c++)
+				alive[r * span + c] = a[r * span + c].is_alive();
+
+		for (int s = 1; s <= steps; s++) {
+			const int c0 = std::max(s, c_begin);
+			const int c1 = std::min(span - s, c_end);
+
+			for (int r = std::max(s, r_begin); r < std::min(span - s, r_end); r++) {
+				const unsigned char* mid = &alive[r * span + c0];
+				NeighborKernel<T>::count(mid - span, mid, mid + span, &counts[0], c1 - c0);
+
+				for (int c = c0; c < c1; c++) {
+					const int i = r * span + c;
+					b[i] = a[i] + (int) counts[c - c0];
+					next_alive[i] = b[i].is_alive();
+				}
+			}
+			a.swap(b);
+			alive.swap(next_alive);
+		}
+
+		return store(t, r_end, c_end);
+	}
+
+	int height;			//max height
+	int width;			//max width
+	int tile;			//the side of a tile
+	int halo;			//the depth of the halo around each tile
+	int span;			//the side of a tile with its halo
+	int tile_rows;		//the number of rows of tiles
+	int tile_cols;		//the number of columns of tiles
+	std::vector<T> board;	//the tiles one after the other, each one span x span cells row by row
+
+	std::vector<T> a;							//the tile being evolved
+	std::vector<T> b;							//the tile being evolved, one generation later
+	std::vector<unsigned char> alive;			//the alive plane of a, only used when NeighborKernel<T>::dense
+	std::vector<unsigned char> next_alive;		//the alive plane of b
+	std::vector<unsigned char> counts;			//the neighbor counts of one row
+
+	int generation;			//generation tracker
+	int population;			//population tracker
+};
+
+#endif